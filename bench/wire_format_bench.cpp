@@ -0,0 +1,156 @@
+/**
+ * =============================================================================
+ * 基准测试: JSON 与 CBOR 订单解码
+ * =============================================================================
+ *
+ * 用同一批订单（默认 100 万条）分别编码为 JSON 与 CBOR，再按 64 KB 一段
+ * 喂给 OrderJsonStream / OrderCborStream，模拟 fetchOrdersFromServer 的流式解码。
+ * 输出两种格式的大小、解码耗时与吞吐量，并校验两边解码结果一致。
+ *
+ * 【构建与运行】
+ *   cmake -S . -B build -DORDERS_BUILD_BENCH=ON
+ *   cmake --build build --target orders-wire-bench
+ *   ./build/bench/orders-wire-bench [订单数] [重复次数]
+ *
+ * 只依赖 Qt Core，不需要 MPF SDK 与 QML 引擎。
+ * =============================================================================
+ */
+
+#include "order_ingest.h"
+#include "order_wire.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+using namespace orders;
+
+namespace {
+
+constexpr qsizetype kChunkSize = 64 * 1024;
+
+QList<Order> makeOrders(int count)
+{
+    static const QString statuses[] = {
+        QStringLiteral("pending"), QStringLiteral("processing"), QStringLiteral("shipped"),
+        QStringLiteral("delivered"), QStringLiteral("cancelled")
+    };
+
+    // 固定的伪随机序列，每次运行的数据相同
+    quint32 seed = 12345;
+    const auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    const QDateTime base(QDate(2024, 1, 1), QTime(0, 0), QTimeZone::UTC);
+    QList<Order> orders;
+    orders.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Order order;
+        order.id = QStringLiteral("ORD-%1").arg(i, 8, 10, QLatin1Char('0'));
+        order.customerName = QStringLiteral("Customer %1").arg(next() % 5000);
+        order.productName = QStringLiteral("Product %1").arg(next() % 800);
+        order.quantity = static_cast<int>(next() % 20) + 1;
+        order.priceMinor = static_cast<qint64>(next() % 100000) + 99;
+        order.status = statuses[next() % 5];
+        order.createdAt = base.addMSecs(qint64(i) * 60000);
+        order.updatedAt = order.createdAt.addMSecs(next() % 86400000);
+        orders.append(order);
+    }
+    return orders;
+}
+
+template <typename Stream>
+bool decode(const QByteArray& payload, QList<Order>& out, QString& error)
+{
+    Stream stream;
+    out.clear();
+    for (qsizetype pos = 0; pos < payload.size(); pos += kChunkSize) {
+        if (!stream.feed(payload.mid(pos, kChunkSize), out)) {
+            break;
+        }
+    }
+    const bool ok = stream.finish();
+    error = stream.errorString();
+    return ok;
+}
+
+/**
+ * @brief 重复解码，返回最快一次的耗时（毫秒）
+ */
+template <typename Stream>
+double bench(const char* name, const QByteArray& payload, int repeat, QList<Order>& out)
+{
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int r = 0; r < repeat; ++r) {
+        QElapsedTimer timer;
+        timer.start();
+        QString error;
+        if (!decode<Stream>(payload, out, error)) {
+            std::fprintf(stderr, "%s: decode failed: %s\n", name, qPrintable(error));
+            return -1;
+        }
+        best = std::min(best, timer.nsecsElapsed());
+    }
+
+    const double ms = best / 1e6;
+    std::printf("%-5s %10.1f MB %10.1f ms %12.0f orders/s %8.1f MB/s\n", name,
+                payload.size() / 1048576.0, ms, out.size() / (ms / 1000.0),
+                payload.size() / 1048576.0 / (ms / 1000.0));
+    return ms;
+}
+
+bool sameOrders(const QList<Order>& a, const QList<Order>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (qsizetype i = 0; i < a.size(); ++i) {
+        const Order& x = a[i];
+        const Order& y = b[i];
+        if (x.id != y.id || x.customerName != y.customerName || x.productName != y.productName
+            || x.quantity != y.quantity || x.priceMinor != y.priceMinor || x.status != y.status
+            || x.createdAt != y.createdAt || x.updatedAt != y.updatedAt) {
+            std::fprintf(stderr, "mismatch at %lld (%s)\n", static_cast<long long>(i), qPrintable(x.id));
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    const int count = args.size() > 1 ? args.at(1).toInt() : 1000000;
+    const int repeat = args.size() > 2 ? std::max(1, args.at(2).toInt()) : 3;
+
+    std::printf("Generating %d orders...\n", count);
+    const QList<Order> orders = makeOrders(count);
+    const QByteArray json = wire::encodeJson(orders);
+    const QByteArray cbor = wire::encodeCbor(orders);
+
+    QList<Order> fromJson;
+    QList<Order> fromCbor;
+    const double jsonMs = bench<OrderJsonStream>("json", json, repeat, fromJson);
+    const double cborMs = bench<OrderCborStream>("cbor", cbor, repeat, fromCbor);
+    if (jsonMs < 0 || cborMs < 0) {
+        return 1;
+    }
+
+    if (!sameOrders(fromJson, fromCbor) || fromCbor.size() != count) {
+        std::fprintf(stderr, "JSON and CBOR decoded different orders\n");
+        return 1;
+    }
+
+    std::printf("cbor/json: %.2fx size, %.2fx speed\n",
+                double(cbor.size()) / json.size(), jsonMs / cborMs);
+    return 0;
+}
@@ -3,17 +3,26 @@
 #include <QObject>
 #include <QVariantList>
 #include <QElapsedTimer>
+#include <QUrl>
 #include <memory>
 
 namespace mpf::http { class HttpClient; }
 
 namespace orders {
 
+class ResponseCache;
+
 /**
  * @brief Demo service for showcasing HTTP client and EventBus capabilities
  *
  * Provides Q_INVOKABLE methods for QML to:
  * - Send HTTP GET/POST requests via mpf::http::HttpClient
+ *   (GETs go through the shared ResponseCache when one is set: fresh
+ *   responses are served from disk, and stale ones are served immediately
+ *   while a conditional request revalidates them in the background, but only
+ *   within a stale-while-revalidate window the server sent. No default window
+ *   applies here, so any other expired response is revalidated before it is
+ *   reported)
  * - Accumulate received EventBus messages for display
  */
 class DemoService : public QObject
@@ -25,6 +34,8 @@ public:
     explicit DemoService(const QString& pluginId, QObject* parent = nullptr);
     ~DemoService() override;
 
+    void setResponseCache(std::shared_ptr<ResponseCache> cache);
+
     // HTTP demo
     Q_INVOKABLE void testGet(const QString& url);
     Q_INVOKABLE void testPost(const QString& url, const QString& jsonBody);
@@ -47,7 +58,10 @@ public slots:
                          const QString& senderId);
 
 private:
+    void revalidate(const QUrl& url, const QByteArray& cacheKey, bool report);
+
     std::unique_ptr<mpf::http::HttpClient> m_httpClient;
+    std::shared_ptr<ResponseCache> m_responseCache;
     QVariantList m_receivedMessages;
     QString m_pluginId;
     QString m_topicPrefix;
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QSet>
+#include "orders_service.h"
+
+#include <vector>
+
+namespace orders {
+
+/**
+ * @brief Live per-group order count, revenue sum and average
+ *
+ * One row per distinct value of the groupBy field ("status",
+ * "customerName" or "productName"), with the number of orders in the group
+ * and the sum and average of their totals:
+ *
+ * @code{.qml}
+ * GroupSummaryModel { service: OrdersService; groupBy: "customerName" }
+ * @endcode
+ *
+ * Groups are keyed by the store's interned string ids and hold integer
+ * minor-unit sums, so no strings are compared and sums do not drift. The
+ * model keeps a snapshot of each order's group and total, and applies
+ * OrdersService::orderChanges by subtracting the old snapshot and adding
+ * the new one: an edit costs O(1) and emits dataChanged for the one or two
+ * affected groups. Updates that touch neither the group field nor the total
+ * are ignored. A group appears as a row insert when its first order arrives
+ * and disappears as a row remove with its last order. Rows are in
+ * first-seen order; sort them in QML if needed. Change sets above
+ * resetThreshold, and explicit resets, rebuild the model.
+ */
+class GroupSummaryModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(QString groupBy READ groupBy WRITE setGroupBy NOTIFY groupByChanged)
+    Q_PROPERTY(int resetThreshold READ resetThreshold WRITE setResetThreshold NOTIFY resetThresholdChanged)
+    Q_PROPERTY(orders::OrdersService* service READ service WRITE setService NOTIFY serviceChanged)
+
+public:
+    enum Roles {
+        KeyRole = Qt::UserRole + 1,
+        CountRole,
+        SumRole,
+        AvgRole
+    };
+
+    static constexpr int kDefaultResetThreshold = 256;
+
+    explicit GroupSummaryModel(QObject* parent = nullptr);
+    ~GroupSummaryModel() override;
+
+    OrdersService* service() const { return m_service; }
+    void setService(OrdersService* service);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QString groupBy() const { return m_groupByName; }
+    void setGroupBy(const QString& field);
+
+    int resetThreshold() const { return m_resetThreshold; }
+    void setResetThreshold(int threshold);
+
+    Q_INVOKABLE void refresh();
+
+    /**
+     * @brief Row as { key, count, sum, avg } (sum and avg in major units)
+     */
+    Q_INVOKABLE QVariantMap get(int index) const;
+
+signals:
+    void countChanged();
+    void groupByChanged();
+    void resetThresholdChanged();
+    void serviceChanged();
+
+private slots:
+    void onOrderChanges(const orders::OrderChangeSet& changes);
+
+private:
+    using Handle = OrderStore::Handle;
+
+    enum class GroupField {
+        Status,
+        CustomerName,
+        ProductName
+    };
+
+    struct Group {
+        StringPool::Id key;
+        int count = 0;
+        qint64 sum = 0;  // minor units
+    };
+
+    void rebuild();
+    StringPool::Id groupOf(Handle handle) const;
+    OrderFields groupFields() const;
+
+    void add(StringPool::Id key, qint64 total, QSet<StringPool::Id>& changed);
+    void subtract(StringPool::Id key, qint64 total, QSet<StringPool::Id>& changed);
+    void emitChanged(const QList<int>& rows);
+
+    OrdersService* m_service = nullptr;
+    QString m_groupByName = QStringLiteral("status");
+    GroupField m_groupBy = GroupField::Status;
+    int m_resetThreshold = kDefaultResetThreshold;
+
+    std::vector<Group> m_groups;                 // row -> group
+    QHash<StringPool::Id, int> m_rowOf;          // group key -> row
+    std::vector<StringPool::Id> m_keyOf;         // handle -> group snapshot (InvalidId: not counted)
+    std::vector<qint64> m_totalOf;               // handle -> total snapshot
+};
+
+} // namespace orders
@@ -0,0 +1,36 @@
+/**
+ * =============================================================================
+ * Money - 定点金额
+ * =============================================================================
+ *
+ * 金额在存储与计算中统一使用 int64 最小货币单位（分）表示，
+ * 累加、统计不会产生浮点舍入误差；只在与 QML / JSON 交互时转换为 double。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+namespace orders::money {
+
+// 1 个主货币单位包含的最小单位数（元 -> 分）
+constexpr qint64 kMinorPerMajor = 100;
+
+/**
+ * @brief 主货币单位（double）-> 最小单位（四舍五入）
+ */
+inline qint64 fromMajor(double amount)
+{
+    return qRound64(amount * kMinorPerMajor);
+}
+
+/**
+ * @brief 最小单位 -> 主货币单位（double），仅用于展示和序列化
+ */
+inline double toMajor(qint64 minor)
+{
+    return static_cast<double>(minor) / kMinorPerMajor;
+}
+
+} // namespace orders::money
@@ -0,0 +1,77 @@
+/**
+ * =============================================================================
+ * Order - 订单数据结构
+ * =============================================================================
+ *
+ * 从 orders_service.h 中拆分出来，供 OrderStore 等存储组件与服务类共用。
+ * toVariantMap/fromVariantMap 的实现仍位于 orders_service.cpp，
+ * fromJson 与 CBOR 编解码位于 order_wire.cpp。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "money.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <QVariantMap>
+#include <QDateTime>
+
+namespace orders {
+
+// =============================================================================
+// 数据结构定义
+// =============================================================================
+
+/**
+ * @brief 订单数据结构
+ * 
+ * 【修改点2】根据你的业务需求定义数据字段
+ * 
+ * 设计建议：
+ * - 使用 QString 而不是 std::string（Qt 生态兼容性）
+ * - 使用 QDateTime 处理时间
+ * - 金额使用 int64 最小货币单位（分），见 money.h
+ * - 提供 toVariantMap/fromVariantMap 用于 QML 交互
+ */
+struct Order {
+    QString id;              // 唯一标识符
+    QString customerName;    // 客户名称
+    QString productName;     // 产品名称
+    int quantity = 0;        // 数量
+    qint64 priceMinor = 0;   // 单价（最小货币单位：分）
+    QString status;          // 状态: pending, processing, shipped, delivered, cancelled
+    QDateTime createdAt;     // 创建时间
+    QDateTime updatedAt;     // 更新时间
+    
+    /**
+     * @brief 订单金额（最小货币单位），quantity × priceMinor
+     */
+    qint64 totalMinor() const { return quantity * priceMinor; }
+    
+    /**
+     * @brief 转换为 QVariantMap
+     * 
+     * 用于将 C++ 结构体传递给 QML
+     * QML 中可以直接访问属性：order.customerName, order.price 等
+     */
+    QVariantMap toVariantMap() const;
+    
+    /**
+     * @brief 从 QVariantMap 创建
+     * 
+     * 用于从 QML 传入的数据创建 C++ 对象
+     */
+    static Order fromVariantMap(const QVariantMap& map);
+    
+    /**
+     * @brief 从服务器返回的 JSON 对象创建
+     * 
+     * 字段与默认值同 fromVariantMap，但直接读取 QJsonObject，
+     * 省去每条订单一次 QVariantMap 转换（流式解析在工作线程调用）
+     */
+    static Order fromJson(const QJsonObject& object);
+};
+
+} // namespace orders
@@ -0,0 +1,60 @@
+/**
+ * =============================================================================
+ * Order Aggregates - 订单统计聚合
+ * =============================================================================
+ *
+ * 随订单增删改实时维护的聚合值：订单总数、总收入、各状态的数量与收入。
+ * 每次变更只做 O(1) 的加减，查询也是 O(1)，不再遍历全部订单。
+ *
+ * 由 OrderStore 在 insert/update/remove/clear 中同步维护，
+ * OrdersService 通过 Q_PROPERTY 暴露给 QML。
+ * 状态以 StringPool 中的驻留 ID 作为键，金额为定点最小单位，累加没有舍入误差。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "money.h"
+#include "string_pool.h"
+
+#include <QHash>
+#include <QVariantMap>
+
+namespace orders {
+
+class OrderAggregates
+{
+public:
+    /**
+     * @brief 单个状态的统计值
+     */
+    struct Bucket {
+        int count = 0;
+        qint64 revenue = 0;  // 最小货币单位
+    };
+
+    void add(StringPool::Id status, qint64 revenue);
+    void remove(StringPool::Id status, qint64 revenue);
+    void clear();
+
+    int count() const { return m_total.count; }
+    qint64 revenue() const { return m_total.revenue; }
+
+    /**
+     * @brief 指定状态的统计值，不存在时返回空 Bucket
+     */
+    Bucket statusBucket(StringPool::Id status) const { return m_byStatus.value(status); }
+
+    /**
+     * @brief 各状态统计，供 QML 使用
+     * @param pool 用于将状态 ID 还原为字符串
+     * @return { status: { count, revenue } }，revenue 已转换为主货币单位
+     */
+    QVariantMap statusSummary(const StringPool& pool) const;
+
+private:
+    Bucket m_total;
+    QHash<StringPool::Id, Bucket> m_byStatus;
+};
+
+} // namespace orders
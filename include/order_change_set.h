@@ -0,0 +1,126 @@
+/**
+ * =============================================================================
+ * Order Change Set - 类型化的订单变更通知
+ * =============================================================================
+ *
+ * ordersChanged() 只说明“有东西变了”，监听方只能整体刷新。
+ * OrderChangeSet 描述一次操作中具体变了什么：
+ * - 哪些订单被插入 / 更新 / 删除（ID + 变更时的 Handle）
+ * - 更新时哪些字段发生了变化（OrderFields 位掩码）
+ * - 对应的 OrderEvent（变化字段的旧值/新值 + 序号，见 order_event.h）
+ * - 存储是否被压缩（Handle 重映射表）
+ * - 是否需要整体重置（如从服务器整体重新加载）
+ *
+ * OrderModel 据此发出 beginInsertRows / beginRemoveRows / dataChanged，
+ * 只刷新受影响的行和角色。
+ *
+ * 【处理顺序】
+ * changes 按发生顺序排列，remap 在所有 changes 之后生效：
+ * changes 中的 Handle 都是压缩前的值。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "order.h"
+#include "order_event.h"
+#include "order_store.h"
+
+#include <QFlags>
+#include <QHash>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+
+namespace orders {
+
+/**
+ * @brief 订单字段（用于描述更新涉及的字段）
+ */
+enum class OrderField : quint32 {
+    None         = 0,
+    CustomerName = 1u << 0,
+    ProductName  = 1u << 1,
+    Quantity     = 1u << 2,
+    Price        = 1u << 3,
+    Status       = 1u << 4,
+    CreatedAt    = 1u << 5,
+    UpdatedAt    = 1u << 6,
+    Total        = 1u << 7   // 派生字段：quantity × price 的结果变化时置位
+};
+Q_DECLARE_FLAGS(OrderFields, OrderField)
+Q_DECLARE_OPERATORS_FOR_FLAGS(OrderFields)
+
+/**
+ * @brief 单个订单的一次变更
+ */
+struct OrderChange
+{
+    enum class Kind {
+        Inserted,
+        Updated,
+        Removed
+    };
+
+    Kind kind = Kind::Updated;
+    OrderStore::Handle handle = OrderStore::InvalidHandle;
+    QString id;
+    OrderFields fields;   // 仅 Updated 有意义
+
+    /**
+     * @brief 比较新旧两个订单，得到发生变化的字段
+     */
+    static OrderFields diff(const Order& before, const Order& after);
+};
+
+/**
+ * @brief 一次操作产生的全部变更
+ */
+struct OrderChangeSet
+{
+    QVector<OrderChange> changes;
+    QVector<OrderEvent> events;          // 带增量的事件，按序号排列（不合并，保留每次变更）
+    QVector<OrderStore::Handle> remap;   // 非空表示存储已压缩：remap[旧 Handle] = 新 Handle
+    bool reset = false;                  // 为 true 时忽略 changes，监听方应整体重建
+
+    bool isEmpty() const { return changes.isEmpty() && events.isEmpty() && remap.isEmpty() && !reset; }
+    int size() const { return static_cast<int>(changes.size()); }
+};
+
+/**
+ * @brief 累积变更并按订单合并，得到一个 OrderChangeSet
+ *
+ * 同一订单在一批操作中的多次变更合并为一条：
+ * - 插入后更新 -> 插入
+ * - 多次更新 -> 一次更新（字段掩码取并集）
+ * - 更新后删除 -> 删除
+ * - 插入后删除 -> 两条都丢弃
+ * 同一 Handle 在两次压缩之间不会被复用，因此以 Handle 作为订单的标识。
+ */
+class OrderChangeBuilder
+{
+public:
+    void inserted(OrderStore::Handle handle, const QString& id);
+    void updated(OrderStore::Handle handle, const QString& id, OrderFields fields);
+    void removed(OrderStore::Handle handle, const QString& id);
+
+    void addEvent(OrderEvent event) { m_set.events.append(std::move(event)); }
+    void setRemap(QVector<OrderStore::Handle> remap) { m_set.remap = std::move(remap); }
+    void setReset() { m_set.reset = true; }
+
+    bool isEmpty() const { return m_set.isEmpty(); }
+
+    /**
+     * @brief 取出累积的变更集并清空
+     */
+    OrderChangeSet take();
+
+private:
+    OrderChangeSet m_set;
+    QHash<OrderStore::Handle, qsizetype> m_positions;  // Handle -> 在 m_set.changes 中的位置
+    int m_dropped = 0;                                 // 已抵消（插入后删除）的条目数
+};
+
+} // namespace orders
+
+Q_DECLARE_METATYPE(orders::OrderChangeSet)
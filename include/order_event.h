@@ -0,0 +1,81 @@
+/**
+ * =============================================================================
+ * Order Event - 携带增量的订单变更事件
+ * =============================================================================
+ *
+ * orderCreated(id) / orderUpdated(id) / orderDeleted(id) 只告诉监听方“哪个订单变了”，
+ * 监听方还得回调 getOrder() 才知道变了什么。OrderEvent 直接携带变化内容：
+ * - sequence: 单调递增的序号（每个服务实例从 1 开始），可用于去重、检测漏收
+ * - type: "created" / "updated" / "deleted"
+ * - before / after: 只包含变化字段的旧值 / 新值
+ *   - created: before 为空，after 为完整订单
+ *   - updated: 两者都只包含 changedFields 中的字段
+ *   - deleted: before 为完整订单，after 为空
+ *
+ * 这是一个 Q_GADGET，QML 中可以直接访问属性：
+ * @code{.qml}
+ * Connections {
+ *     target: OrdersService
+ *     function onOrderEvent(event) {
+ *         if (event.type === "updated" && event.changedFields.includes("status"))
+ *             console.log(event.id, event.before.status, "->", event.after.status)
+ *     }
+ * }
+ * @endcode
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "order.h"
+
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+namespace orders {
+
+class OrderEvent
+{
+    Q_GADGET
+    Q_PROPERTY(qint64 sequence MEMBER sequence)
+    Q_PROPERTY(QString type READ typeName)
+    Q_PROPERTY(QString id MEMBER id)
+    Q_PROPERTY(QStringList changedFields READ changedFields)
+    Q_PROPERTY(QVariantMap before MEMBER before)
+    Q_PROPERTY(QVariantMap after MEMBER after)
+
+public:
+    enum class Type {
+        Created,
+        Updated,
+        Deleted
+    };
+    Q_ENUM(Type)
+
+    qint64 sequence = 0;
+    Type type = Type::Updated;
+    QString id;
+    QVariantMap before;
+    QVariantMap after;
+
+    QString typeName() const;
+
+    /**
+     * @brief 变化的字段名（created / deleted 为订单的全部字段）
+     */
+    QStringList changedFields() const;
+
+    static OrderEvent created(qint64 sequence, const Order& order);
+    static OrderEvent deleted(qint64 sequence, const Order& order);
+
+    /**
+     * @brief 只保留 before 与 after 之间不同的字段
+     */
+    static OrderEvent updated(qint64 sequence, const Order& before, const Order& after);
+};
+
+} // namespace orders
+
+Q_DECLARE_METATYPE(orders::OrderEvent)
@@ -0,0 +1,88 @@
+/**
+ * =============================================================================
+ * Order ID Generator - 订单 ID 生成器
+ * =============================================================================
+ *
+ * OrdersService 通过 OrderIdGenerator 接口生成新订单 ID，可替换为其他实现
+ * （如服务端分配、测试用的确定性序列）。
+ *
+ * 【默认实现：SnowflakeIdGenerator】
+ * 64 位 ID = 41 位毫秒时间戳 | 10 位节点号 | 12 位序列号
+ * - 同一毫秒内最多 4096 个 ID，序列号用完时借用下一毫秒（逻辑时钟），不阻塞
+ * - 时钟回拨时沿用上一次的时间戳继续递增，保证单调
+ * - 多线程无锁：状态保存在一个 std::atomic 中，用 CAS 推进
+ * - 编码为 13 位 Crockford Base32（定长、按数值大小排序），
+ *   字符串的字典序即创建时间顺序，可直接当作时间索引使用
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <atomic>
+
+namespace orders {
+
+class OrderIdGenerator
+{
+public:
+    virtual ~OrderIdGenerator() = default;
+
+    /**
+     * @brief 生成下一个 ID（实现需保证线程安全）
+     */
+    virtual QString next() = 0;
+};
+
+class SnowflakeIdGenerator : public OrderIdGenerator
+{
+public:
+    static constexpr int kSequenceBits = 12;
+    static constexpr int kNodeBits = 10;
+    static constexpr int kTimestampBits = 64 - kNodeBits - kSequenceBits - 1;  // 最高位保留为 0
+    static constexpr quint32 kMaxNodeId = (1u << kNodeBits) - 1;
+
+    // 自定义纪元：2025-01-01T00:00:00Z，41 位毫秒时间戳可用约 69 年
+    static constexpr qint64 kEpochMs = 1735689600000LL;
+
+    // 编码后的字符串长度
+    static constexpr int kEncodedLength = 13;
+
+    /**
+     * @param nodeId 节点号 [0, kMaxNodeId]，多实例并发生成时应各不相同
+     */
+    explicit SnowflakeIdGenerator(quint32 nodeId);
+
+    QString next() override { return encode(nextRaw()); }
+
+    /**
+     * @brief 生成下一个 64 位 ID
+     */
+    quint64 nextRaw();
+
+    quint32 nodeId() const { return m_nodeId; }
+
+    /**
+     * @brief 64 位 ID -> 13 位 Crockford Base32
+     */
+    static QString encode(quint64 id);
+
+    /**
+     * @brief 13 位 Crockford Base32 -> 64 位 ID（大小写不敏感）
+     * @param ok 可选，解码失败时置为 false
+     */
+    static quint64 decode(QStringView text, bool* ok = nullptr);
+
+    /**
+     * @brief 从 ID 中取出创建时间（epoch 毫秒）
+     */
+    static qint64 timestampMs(quint64 id);
+
+private:
+    const quint32 m_nodeId;
+    // (相对纪元的毫秒 << kSequenceBits) | 序列号，序列号溢出时自然进位到时间戳
+    std::atomic<quint64> m_state{0};
+};
+
+} // namespace orders
@@ -0,0 +1,162 @@
+/**
+ * =============================================================================
+ * Order Ingest - 流式 JSON 订单解析（工作线程）
+ * =============================================================================
+ *
+ * fetchOrdersFromServer 的响应可能有几十 MB。整体 readAll() + QJsonDocument
+ * 再逐个 toVariantMap() 都在 GUI 线程进行，会让界面卡住数秒。这里拆成两部分：
+ *
+ * - OrderJsonStream: 增量切分顶层 JSON 数组。每收到一段字节就扫描一次，
+ *   每个完整的数组元素单独解析为 QJsonObject，再直接转换为 Order
+ *   （Order::fromJson，不经过 QVariantMap）。只缓存尚未结束的那个元素的字节。
+ * - OrderCborStream: 同样的增量接口，解码 CBOR 数组（格式见 order_wire.h），
+ *   用 QCborStreamReader 直接写入 Order，不经过 QJsonObject / QCborValue。
+ * - OrderIngestWorker: 运行在工作线程上的 QObject，按 begin() 指定的格式
+ *   包装 OrderJsonStream 或 OrderCborStream，
+ *   每凑满 batchSize 条订单通过 batchReady 交回一批（跨线程为排队连接）。
+ *
+ * 每次抓取用 generation 标识：新的抓取开始后，旧抓取残留的批次由接收方丢弃。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "order.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+namespace orders {
+
+class OrderJsonStream
+{
+public:
+    /**
+     * @brief 追加一段字节，解析出已完整的订单
+     * @param chunk 响应的下一段字节（可在任意位置切开，包括 UTF-8 多字节字符中间）
+     * @param out 新解析出的订单追加到这里；非对象的数组元素被跳过
+     * @return 格式错误（数组前后或元素之间有多余内容、元素本身不是合法 JSON）
+     *         时返回 false，见 errorString()
+     */
+    bool feed(const QByteArray& chunk, QList<Order>& out);
+
+    /**
+     * @brief 输入结束，检查数组是否完整闭合
+     *
+     * 停在元素中间或数组未闭合（响应被截断）时返回 false，已解析出的订单不完整
+     */
+    bool finish();
+
+    void reset();
+
+    bool hasError() const { return !m_error.isEmpty(); }
+    QString errorString() const { return m_error; }
+
+private:
+    // 顶层数组的语法位置（元素之外），元素内部只跟踪嵌套与字符串
+    enum class Expect {
+        ArrayStart,   // 数组开始之前：只允许空白与 '['
+        FirstValue,   // '[' 之后：元素或 ']'
+        Value,        // ',' 之后：必须是元素
+        CommaOrEnd,   // 元素之后：',' 或 ']'
+        End           // 顶层数组已闭合：只允许空白
+    };
+
+    bool completeElement(const char* data, qsizetype end, QList<Order>& out);
+    bool fail(const QString& error);
+
+    QByteArray m_buffer;       // 尚未消费的字节（从当前元素的起点开始）
+    qsizetype m_scan = 0;      // m_buffer 中下一个待扫描的位置
+    qsizetype m_element = -1;  // 当前顶层元素在 m_buffer 中的起点，-1 表示不在元素内
+    int m_depth = 0;           // 嵌套深度，1 表示位于顶层数组内
+    Expect m_expect = Expect::ArrayStart;
+    bool m_inString = false;
+    bool m_escape = false;
+    bool m_scalar = false;     // 当前元素是数字或 true/false/null
+    QString m_error;
+};
+
+class OrderCborStream
+{
+public:
+    /**
+     * @brief 追加一段字节，解码出已完整的订单
+     * @param chunk 响应的下一段字节（可在任意位置切开）
+     * @param out 新解码出的订单追加到这里
+     * @return 格式错误时返回 false，见 errorString()
+     */
+    bool feed(const QByteArray& chunk, QList<Order>& out);
+
+    /**
+     * @brief 输入结束，检查数组是否完整
+     */
+    bool finish();
+
+    void reset();
+
+    bool hasError() const { return !m_error.isEmpty(); }
+    QString errorString() const { return m_error; }
+
+private:
+    bool readHeader();
+    bool fail(const QString& error);
+
+    QByteArray m_buffer;       // 尚未消费的字节（从下一个元素的起点开始）
+    bool m_started = false;    // 数组头已读取
+    qint64 m_remaining = -1;   // 定长数组剩余的元素数，-1 表示不定长
+    bool m_done = false;       // 数组已结束
+    QString m_error;
+};
+
+class OrderIngestWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultBatchSize = 1000;
+
+    enum class Format { Json, Cbor };
+
+    explicit OrderIngestWorker(int batchSize = kDefaultBatchSize, QObject* parent = nullptr);
+
+public slots:
+    /**
+     * @brief 开始新一次抓取，丢弃上一次未完成的解析状态
+     * @param format 响应体的格式（由 Content-Type 决定）
+     */
+    void begin(quint64 generation, Format format = Format::Json);
+
+    void feed(quint64 generation, const QByteArray& chunk);
+
+    /**
+     * @brief 输入结束：交回最后不足一批的订单，然后发出 finished
+     */
+    void finish(quint64 generation);
+
+signals:
+    void batchReady(quint64 generation, const QList<orders::Order>& orders);
+
+    /**
+     * @param ok 数组完整且格式正确
+     * @param error ok 为 false 时的错误信息
+     * @param total 本次解析出的订单数
+     */
+    void finished(quint64 generation, bool ok, const QString& error, int total);
+
+private:
+    void flush(bool force);
+    bool hasError() const;
+    QString errorString() const;
+
+    int m_batchSize;
+    quint64 m_generation = 0;
+    Format m_format = Format::Json;
+    OrderJsonStream m_json;
+    OrderCborStream m_cbor;
+    QList<Order> m_pending;
+    int m_total = 0;
+};
+
+} // namespace orders
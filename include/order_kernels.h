@@ -0,0 +1,68 @@
+/**
+ * =============================================================================
+ * Order Kernels - 列式聚合内核
+ * =============================================================================
+ *
+ * 面向 OrderStore 列的批量计算内核：求和、按键过滤求和、按键过滤的最小/最大值。
+ * 输入是 int64 金额列（最小货币单位，quantity × price）和 uint32 键列（如状态 ID）。
+ *
+ * 【运行时分派】
+ * 首次调用时检测 CPU 特性，选择最快的实现：
+ * - AVX2：每次处理 8 行
+ * - SSE4.2：每次处理 4 行
+ * - 标量：其他平台或不支持上述指令集时的回退实现
+ * 所有实现的结果完全一致（整数运算，无舍入误差）。
+ *
+ * 本文件只依赖标准库，不依赖 Qt。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace orders::kernels {
+
+/**
+ * @brief 过滤后的最小/最大值
+ *
+ * count 为 0 时 min/max 无意义
+ */
+struct MinMax {
+    std::int64_t min = 0;
+    std::int64_t max = 0;
+    std::size_t count = 0;
+};
+
+/**
+ * @brief values[0..n) 求和
+ */
+std::int64_t sum(const std::int64_t* values, std::size_t n);
+
+/**
+ * @brief 对 keys[i] == key 的行求 values[i] 之和
+ */
+std::int64_t sumWhere(const std::int64_t* values, const std::uint32_t* keys,
+                      std::uint32_t key, std::size_t n);
+
+/**
+ * @brief 对 keys[i] == key 的行求 values[i] 的最小/最大值
+ */
+MinMax minMaxWhere(const std::int64_t* values, const std::uint32_t* keys,
+                   std::uint32_t key, std::size_t n);
+
+/**
+ * @brief 对 keys[i] != excluded 的行求 values[i] 的最小/最大值
+ *
+ * 用于跳过墓碑行（墓碑行的键为保留值）
+ */
+MinMax minMaxExcept(const std::int64_t* values, const std::uint32_t* keys,
+                    std::uint32_t excluded, std::size_t n);
+
+/**
+ * @brief 当前选用的实现名称："avx2" / "sse4.2" / "scalar"
+ */
+const char* activeIsa();
+
+} // namespace orders::kernels
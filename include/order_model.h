@@ -1,20 +1,56 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QSet>
+#include <QTimer>
+#include "order_page_cache.h"
 #include "orders_service.h"
 
+#include <vector>
+
 namespace orders {
 
 /**
  * @brief List model for orders
  * 
  * Exposes orders to QML ListView/Repeater.
+ *
+ * The model follows OrdersService::orderChanges and applies each change set
+ * as row inserts/removes and dataChanged() limited to the affected roles, so
+ * delegates and the scroll position survive edits. Change sets larger than
+ * resetThreshold (or explicit resets such as a server reload) fall back to
+ * a full model reset.
+ *
+ * The model does not copy orders: each row is just a handle into the
+ * service's OrderStore, and data() reads the typed column for the requested
+ * role. Rows are kept in store order (ascending handle), so rows are located
+ * by binary search. Compaction remaps arrive with the change set.
+ *
+ * Paged mode (paged: true) is meant for very large books. The model then
+ * keeps no per-row state at all: rows are exposed incrementally through
+ * canFetchMore()/fetchMore(), and only a bounded number of pages around the
+ * viewport are materialized (OrderPageCache, maxCachedPages x pageSize
+ * orders). Pages come from the service store through OrdersService's query
+ * engine, or, when sourceUrl is set, from the server via
+ * OrdersService::fetchOrdersPage(). Pages that were evicted are loaded
+ * again when scrolled back into view: local pages are re-queried in place
+ * from data(), remote pages are requested from the event loop and announced
+ * through dataChanged(). Local edits are applied to the loaded pages as row
+ * diffs (dataChanged/rowsInserted/rowsRemoved); only a change whose row
+ * position cannot be told from the cached pages drops the cache (a reset
+ * that keeps the exposed row window).
  */
 class OrderModel : public QAbstractListModel
 {
     Q_OBJECT
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(QString filterStatus READ filterStatus WRITE setFilterStatus NOTIFY filterStatusChanged)
+    Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
+    Q_PROPERTY(int resetThreshold READ resetThreshold WRITE setResetThreshold NOTIFY resetThresholdChanged)
+    Q_PROPERTY(bool paged READ paged WRITE setPaged NOTIFY pagedChanged)
+    Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged)
+    Q_PROPERTY(int maxCachedPages READ maxCachedPages WRITE setMaxCachedPages NOTIFY maxCachedPagesChanged)
+    Q_PROPERTY(QString sourceUrl READ sourceUrl WRITE setSourceUrl NOTIFY sourceUrlChanged)
     Q_PROPERTY(orders::OrdersService* service READ service WRITE setService NOTIFY serviceChanged)
 
 public:
@@ -30,6 +66,10 @@ public:
         TotalRole
     };
 
+    static constexpr int kDefaultResetThreshold = 256;
+    static constexpr int kDefaultPageSize = 100;
+    static constexpr int kDefaultMaxCachedPages = 10;
+
     explicit OrderModel(QObject* parent = nullptr);
     explicit OrderModel(OrdersService* service, QObject* parent = nullptr);
     ~OrderModel() override;
@@ -41,11 +81,36 @@ public:
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    // Role helpers shared with SortedOrderModel
+    static QVariant roleData(const OrderView& order, int role);
+    static QHash<int, QByteArray> orderRoleNames();
+    static QList<int> rolesFor(OrderFields fields);
 
     // Filter
     QString filterStatus() const { return m_filterStatus; }
     void setFilterStatus(const QString& status);
 
+    // Search (customer / product name substring, combined with filterStatus)
+    QString searchText() const { return m_searchText; }
+    void setSearchText(const QString& text);
+
+    // Changes per change set above which the model resets instead of diffing
+    int resetThreshold() const { return m_resetThreshold; }
+    void setResetThreshold(int threshold);
+
+    // Paging (see class comment)
+    bool paged() const { return m_paged; }
+    void setPaged(bool paged);
+    int pageSize() const { return m_pages.pageSize(); }
+    void setPageSize(int size);
+    int maxCachedPages() const { return m_pages.capacity(); }
+    void setMaxCachedPages(int pages);
+    QString sourceUrl() const { return m_sourceUrl; }
+    void setSourceUrl(const QString& url);
+
     // Actions
     Q_INVOKABLE void refresh();
     Q_INVOKABLE QVariantMap get(int index) const;
@@ -53,17 +118,52 @@ public:
 signals:
     void countChanged();
     void filterStatusChanged();
+    void searchTextChanged();
+    void resetThresholdChanged();
+    void pagedChanged();
+    void pageSizeChanged();
+    void maxCachedPagesChanged();
+    void sourceUrlChanged();
+    void fetchFailed(const QString& message);
     void serviceChanged();
 
 private slots:
-    void onOrdersChanged();
+    void onOrderChanges(const orders::OrderChangeSet& changes);
 
 private:
     void updateFilteredOrders();
+    bool matchesFilter(OrderStore::Handle handle) const;
+    bool matchesFilter(const Order& order) const;
+    int rowOf(OrderStore::Handle handle) const;
+    void insertRow(OrderStore::Handle handle);
+    void removeRow(int row);
+
+    // Paged mode
+    void resetPages(int keepRows);
+    void loadPage(int page);
+    void loadRequestedPages();
+    void applyPage(quint64 generation, int page, const OrderPage& result);
+    void applyPagedChanges(const OrderChangeSet& changes);
+    void insertPagedRow(int row);
+    void removePagedRow(int row);
+    OrderPage queryLocalPage(int page) const;
+    const Order* pagedRow(int row) const;
 
     OrdersService* m_service = nullptr;
-    QVariantList m_filteredOrders;
+    std::vector<OrderStore::Handle> m_rowHandles;  // row -> store handle, ascending
     QString m_filterStatus;
+    QString m_searchText;
+    int m_resetThreshold = kDefaultResetThreshold;
+
+    bool m_paged = false;
+    QString m_sourceUrl;
+    // Page cache and remote page requests are filled from data() (const)
+    mutable OrderPageCache m_pages{kDefaultPageSize, kDefaultMaxCachedPages};
+    mutable QSet<int> m_requestedPages;  // remote pages data() asked for
+    mutable QTimer m_requestTimer;       // single shot, runs loadRequestedPages()
+    int m_loadedRows = 0;       // rows exposed so far (rowCount in paged mode)
+    int m_totalRows = -1;       // total matching rows, -1 while unknown
+    quint64 m_generation = 0;   // bumped on reset; stale page replies are dropped
 };
 
 } // namespace orders
@@ -0,0 +1,95 @@
+/**
+ * =============================================================================
+ * Order Page Cache - 分页模式下的订单页缓存
+ * =============================================================================
+ *
+ * OrderModel 分页模式只在内存中保留视口附近的若干页订单：
+ * - 页号 = 行号 / pageSize，每页保存该页订单的值（Order）
+ * - 容量以页为单位；插入新页后，淘汰离“锚点页”（最近访问或请求的页，近似视口位置）
+ *   最远的页，直到不超过容量
+ * - 同一页的请求在返回前只发一次（pending 标记）
+ *
+ * 内存占用上限约为 capacity × pageSize 个订单，与总行数无关。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "order.h"
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+namespace orders {
+
+class OrderPageCache
+{
+public:
+    explicit OrderPageCache(int pageSize = 100, int capacity = 10);
+
+    int pageSize() const { return m_pageSize; }
+    int capacity() const { return m_capacity; }
+
+    /**
+     * @brief 修改页大小（清空缓存）/ 容量（立即按锚点淘汰）
+     */
+    void setPageSize(int pageSize);
+    void setCapacity(int capacity);
+
+    int pageOf(int row) const { return row / m_pageSize; }
+
+    /**
+     * @brief 取一行订单，所在页未缓存时返回 nullptr
+     *
+     * 命中时该页成为新的锚点页
+     */
+    const Order* row(int row);
+
+    bool hasPage(int page) const { return m_pages.contains(page); }
+    bool isPending(int page) const { return m_pending.contains(page); }
+    void markPending(int page) { m_pending.insert(page); m_anchor = page; }
+
+    /**
+     * @brief 存入一页，并淘汰离锚点最远的页
+     */
+    void insert(int page, QVector<Order> rows);
+
+    /**
+     * @brief 取消页的 pending 标记（请求失败时）
+     */
+    void cancel(int page) { m_pending.remove(page); }
+
+    /**
+     * @brief 按订单 ID 在已缓存的页中查找行号，未缓存时返回 -1
+     *
+     * 只做查找，不移动锚点页
+     */
+    int findRow(const QString& id) const;
+
+    /**
+     * @brief 替换已缓存的一行（行所在页未缓存时忽略）
+     */
+    void update(int row, Order order);
+
+    /**
+     * @brief 丢弃 page 及其后的所有页（含 pending 标记）
+     *
+     * 在 page 所在位置插入或删除行后，这些页的行号整体错位，按需重新载入
+     */
+    void dropFrom(int page);
+
+    int cachedPages() const { return static_cast<int>(m_pages.size()); }
+    void clear();
+
+private:
+    void evict();
+
+    int m_pageSize;
+    int m_capacity;
+    int m_anchor = 0;                       // 最近访问或请求的页
+    QHash<int, QVector<Order>> m_pages;     // 页号 -> 该页订单
+    QSet<int> m_pending;                    // 已请求、尚未返回的页
+};
+
+} // namespace orders
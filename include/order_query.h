@@ -0,0 +1,97 @@
+/**
+ * =============================================================================
+ * Order Query - 订单分页查询描述
+ * =============================================================================
+ *
+ * OrdersService::queryOrders() 的参数在 C++ 侧的类型化表示：
+ * 筛选条件 + 排序字段 + 分页窗口。由 OrderStore::query() 执行。
+ *
+ * 【QML 参数格式】
+ * @code{.qml}
+ * OrdersService.queryOrders({
+ *     filter: {
+ *         status: "pending",            // 状态（精确匹配）
+ *         search: "acme",               // 客户名/产品名子串（忽略大小写）
+ *         customerName: "Acme Corp",    // 客户名（精确匹配）
+ *         productName: "Widget",        // 产品名（精确匹配）
+ *         minTotal: 10, maxTotal: 500,  // 订单金额区间 [min, max]
+ *         createdFrom: d1, createdTo: d2,   // 创建时间 [from, to)
+ *         updatedFrom: d3, updatedTo: d4    // 更新时间 [from, to)
+ *     },
+ *     sortBy: "total",                  // 见 SortKey，缺省为创建顺序
+ *     descending: true,
+ *     offset: 0,
+ *     limit: 50                         // 缺省 50，<= 0 表示不限
+ * })
+ * @endcode
+ * 所有筛选条件都是可选的，多个条件之间为“与”关系。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "order_store.h"
+
+#include <QString>
+#include <QVariantMap>
+#include <vector>
+
+namespace orders {
+
+struct OrderQuery
+{
+    enum class SortKey {
+        None,          // 创建顺序（Handle 顺序）
+        Id,
+        CustomerName,
+        ProductName,
+        Status,
+        Quantity,
+        Price,
+        Total,
+        CreatedAt,
+        UpdatedAt
+    };
+
+    static constexpr int kDefaultLimit = 50;
+
+    // 筛选条件（空字符串 / NullTime 表示不限）
+    QString status;
+    QString search;
+    QString customerName;
+    QString productName;
+    bool hasMinTotal = false;
+    bool hasMaxTotal = false;
+    qint64 minTotalMinor = 0;
+    qint64 maxTotalMinor = 0;
+    qint64 createdFromMs = OrderStore::NullTime;
+    qint64 createdToMs = OrderStore::NullTime;
+    qint64 updatedFromMs = OrderStore::NullTime;
+    qint64 updatedToMs = OrderStore::NullTime;
+
+    // 排序与分页
+    SortKey sortBy = SortKey::None;
+    bool descending = false;
+    int offset = 0;
+    int limit = kDefaultLimit;
+
+    /**
+     * @brief 从 QML 传入的参数构造（格式见文件头）
+     *
+     * 无法识别的 sortBy 按 SortKey::None 处理
+     */
+    static OrderQuery fromVariantMap(const QVariantMap& map);
+
+    static SortKey sortKeyFromString(const QString& name);
+};
+
+/**
+ * @brief 查询结果：当前页的 Handle + 匹配总数
+ */
+struct OrderQueryResult
+{
+    std::vector<OrderStore::Handle> handles;
+    int total = 0;
+};
+
+} // namespace orders
@@ -0,0 +1,365 @@
+/**
+ * =============================================================================
+ * Order Store - 订单列式存储
+ * =============================================================================
+ *
+ * OrdersService 内部使用的订单容器，替代原先的 QList<Order> + std::find_if。
+ *
+ * 【存储结构】
+ * - 列式布局：每个字段一列（structure-of-arrays），行号即 Handle
+ *   - id 列：指向 StringArena 的 QStringView
+ *   - customerName / productName / status 列：StringPool 驻留 ID（4 字节）
+ *   - quantity 列：int32；price / lineTotal 列：int64 定点金额（分）
+ *   - createdAt / updatedAt 列：epoch 毫秒
+ *   统计、筛选只需顺序扫描相关的几列，缓存友好；重复字符串只保存一份
+ * - 主键索引：QHash<id, Handle>，按 ID 查找为 O(1)
+ * - 状态索引：QHash<status ID, 有序 Handle 列表>，随增删改增量维护，
+ *   按状态筛选的代价与匹配行数成正比，而不是与总行数成正比；
+ *   删除与改状态为 O(1)，失效项在下次读取时批量过滤（见 RowBucket）
+ * - 时间索引：createdAt / updatedAt 各一个 TimeIndex，范围查询 O(log n + k)
+ * - 搜索索引：客户名/产品名的 TrigramIndex（按驻留字符串建立）+ 每个名字的
+ *   有序 Handle 列表，子串搜索只触及匹配的名字及其订单
+ * - 分页查询：query() 组合上述索引完成筛选，只对请求的页做部分排序
+ * - 统计聚合：OrderAggregates 随每次变更 O(1) 更新；
+ *   需要扫描的统计（最小/最大金额等）由 order_kernels 的 SIMD 内核在列上完成
+ * - 墓碑删除：删除只标记行为无效，O(1)，不移动其他元素
+ * - 压缩：墓碑数量超过阈值时由调用方触发 compact()，回收空行
+ *
+ * 【内存分配】
+ * 各列是少数几个大数组，ID 与驻留字符串的字符内容放在 StringArena 的大块中，
+ * 批量加载前可调用 reserve() 一次性分配；clear() 只复位游标、保留容量，
+ * 整体重新加载时不会逐个释放/分配字符串。
+ *
+ * 【Order 与 OrderView】
+ * Order 仍是写入时使用的值类型（DTO）；读取时 at() 返回 OrderView，
+ * 它只是 (store, handle) 的轻量视图，按需从各列取字段。
+ *
+ * 【Handle 稳定性】
+ * Handle 在两次压缩之间保持稳定；compact() 会保持存活订单的相对顺序，
+ * 并返回旧 Handle -> 新 Handle 的映射，持有 Handle 的组件据此重映射。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "order.h"
+#include "order_aggregates.h"
+#include "string_arena.h"
+#include "string_pool.h"
+#include "time_index.h"
+#include "trigram_index.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QStringView>
+#include <QVector>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace orders {
+
+class OrderStore;
+struct OrderQuery;
+struct OrderQueryResult;
+
+/**
+ * @brief 存储中一行订单的只读视图
+ *
+ * 视图不拥有数据，只在 Handle 存活期间有效
+ */
+class OrderView
+{
+public:
+    OrderView(const OrderStore* store, quint32 handle) : m_store(store), m_handle(handle) {}
+
+    quint32 handle() const { return m_handle; }
+
+    // 字符串字段返回副本，可安全交给 QML；*View() 为零拷贝版本，只在存储内部使用
+    QString id() const { return idView().toString(); }
+    QString customerName() const { return customerNameView().toString(); }
+    QString productName() const { return productNameView().toString(); }
+    QString status() const { return statusView().toString(); }
+
+    QStringView idView() const;
+    QStringView customerNameView() const;
+    QStringView productNameView() const;
+    QStringView statusView() const;
+
+    int quantity() const;
+    qint64 priceMinor() const;
+    QDateTime createdAt() const;
+    QDateTime updatedAt() const;
+    qint64 totalMinor() const;
+
+    double price() const { return money::toMajor(priceMinor()); }
+    double total() const { return money::toMajor(totalMinor()); }
+
+    /**
+     * @brief 物化为独立的 Order 值
+     */
+    Order toOrder() const;
+
+    /**
+     * @brief 转换为 QVariantMap（字段与 Order::toVariantMap 一致）
+     */
+    QVariantMap toVariantMap() const { return toOrder().toVariantMap(); }
+
+private:
+    const OrderStore* m_store;
+    quint32 m_handle;
+};
+
+class OrderStore
+{
+public:
+    using Handle = quint32;
+    static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+
+    // 空时间（无效 QDateTime）在时间列中的表示
+    static constexpr qint64 NullTime = std::numeric_limits<qint64>::min();
+
+    /**
+     * @brief 收入分布统计（金额为最小货币单位）
+     */
+    struct RevenueStats {
+        int count = 0;
+        qint64 sumMinor = 0;
+        qint64 minMinor = 0;   // 单笔订单最小金额，count 为 0 时为 0
+        qint64 maxMinor = 0;   // 单笔订单最大金额，count 为 0 时为 0
+    };
+
+    OrderStore() = default;
+
+    /**
+     * @brief 追加订单
+     * @return 新订单的 Handle；ID 已存在时返回 InvalidHandle
+     */
+    Handle insert(const Order& order);
+
+    /**
+     * @brief 按 ID 查找
+     * @return 订单 Handle，不存在时返回 InvalidHandle
+     */
+    Handle find(QStringView id) const { return m_index.value(id, InvalidHandle); }
+
+    bool contains(QStringView id) const { return m_index.contains(id); }
+    bool isAlive(Handle handle) const { return handle < m_alive.size() && m_alive[handle]; }
+
+    /**
+     * @brief 访问订单（调用方需保证 Handle 存活）
+     */
+    OrderView at(Handle handle) const { return OrderView(this, handle); }
+
+    /**
+     * @brief 整体替换订单字段，并维护二级索引
+     *
+     * id 不允许修改，ID 变化需先 remove 再 insert
+     * @return Handle 无效或 id 不一致时返回 false
+     */
+    bool update(Handle handle, const Order& order);
+
+    /**
+     * @brief 指定状态的所有订单 Handle（按插入顺序）
+     */
+    const std::vector<Handle>& handlesWithStatus(const QString& status) const;
+
+    /**
+     * @brief 创建时间 / 更新时间落在 [fromMs, toMs) 内的订单 Handle，按时间升序
+     *
+     * 时间为空的订单不参与索引
+     */
+    std::vector<Handle> handlesCreatedBetween(qint64 fromMs, qint64 toMs) const { return m_createdIndex.range(fromMs, toMs); }
+    std::vector<Handle> handlesUpdatedBetween(qint64 fromMs, qint64 toMs) const { return m_updatedIndex.range(fromMs, toMs); }
+
+    /**
+     * @brief 客户名或产品名包含 query（忽略大小写）的订单 Handle，按插入顺序
+     *
+     * query 不少于 3 个字符时走 trigram 索引；更短时扫描驻留池中的名字。
+     * @param limit 最多返回的条数，<= 0 表示不限
+     */
+    std::vector<Handle> search(QStringView query, int limit) const;
+
+    /**
+     * @brief 筛选 + 排序 + 分页（见 order_query.h）
+     *
+     * 以最窄的索引（精确匹配的状态/客户/产品桶、搜索、时间范围）作为候选集，
+     * 其余条件逐行在列上校验；排序只对请求的窗口做 nth_element + partial_sort，
+     * 代价为 O(m + k log k)（m 为匹配数，k 为页大小），而不是对全部结果排序。
+     */
+    OrderQueryResult query(const OrderQuery& query) const;
+
+    /**
+     * @brief 实时统计（总数、总收入、各状态统计）
+     */
+    const OrderAggregates& aggregates() const { return m_aggregates; }
+
+    /**
+     * @brief 扫描金额列得到收入分布（所有存活订单 / 指定状态）
+     *
+     * 使用 SIMD 内核，O(n) 但对百万行仍是毫秒级
+     */
+    RevenueStats revenueStats() const;
+    RevenueStats revenueStats(const QString& status) const;
+
+    /**
+     * @brief 字符串驻留池（用于将字符串列的 ID 还原为字符串）
+     */
+    const StringPool& strings() const { return m_strings; }
+
+    // -------------------------------------------------------------------------
+    // 列访问（行号即 Handle，墓碑行的内容无意义，需配合 isAlive 使用）
+    // -------------------------------------------------------------------------
+    QStringView idAt(Handle handle) const { return m_ids[handle]; }
+    StringPool::Id customerIdAt(Handle handle) const { return m_customer[handle]; }
+    StringPool::Id productIdAt(Handle handle) const { return m_product[handle]; }
+    StringPool::Id statusIdAt(Handle handle) const { return m_status[handle]; }
+    qint32 quantityAt(Handle handle) const { return m_quantity[handle]; }
+    qint64 priceMinorAt(Handle handle) const { return m_priceMinor[handle]; }
+    qint64 lineTotalAt(Handle handle) const { return m_lineTotal[handle]; }
+    qint64 createdAtMs(Handle handle) const { return m_createdAt[handle]; }
+    qint64 updatedAtMs(Handle handle) const { return m_updatedAt[handle]; }
+    size_t contentHashAt(Handle handle) const { return m_contentHash[handle]; }
+
+    /**
+     * @brief 订单内容（除 id 外的全部字段）的哈希，与 contentHashAt 可比
+     *
+     * 合并服务器数据时先比较哈希：相同即视为未变化，不必逐字段读取比较
+     */
+    static size_t contentHash(const Order& order);
+
+    /**
+     * @brief 墓碑删除
+     * @return 是否删除成功
+     */
+    bool remove(Handle handle);
+
+    /**
+     * @brief 清空所有订单
+     *
+     * 列与字符串块都保留已分配的容量，供下一轮加载复用
+     */
+    void clear();
+
+    /**
+     * @brief 为批量加载预留容量（各列一次性分配）
+     */
+    void reserve(int rows);
+
+    int size() const { return m_liveCount; }
+    bool isEmpty() const { return m_liveCount == 0; }
+
+    /**
+     * @brief 行总数（包含墓碑），Handle 的取值范围为 [0, slotCount)
+     */
+    Handle slotCount() const { return static_cast<Handle>(m_ids.size()); }
+
+    /**
+     * @brief 墓碑数量是否已超过压缩阈值
+     *
+     * 阈值：墓碑数量不少于 kMinTombstonesForCompaction 且超过存活数量
+     */
+    bool needsCompaction() const;
+
+    /**
+     * @brief 压缩各列，移除所有墓碑
+     * @return 映射表 remap[旧 Handle] = 新 Handle（已删除的为 InvalidHandle）
+     */
+    QVector<Handle> compact();
+
+    /**
+     * @brief 按插入顺序遍历所有存活订单
+     *
+     * f 的签名: void(Handle, const OrderView&)
+     */
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        const Handle n = slotCount();
+        for (Handle h = 0; h < n; ++h) {
+            if (m_alive[h]) {
+                f(h, OrderView(this, h));
+            }
+        }
+    }
+
+    static qint64 toMs(const QDateTime& dt) { return dt.isValid() ? dt.toMSecsSinceEpoch() : NullTime; }
+    static QDateTime fromMs(qint64 ms) { return ms == NullTime ? QDateTime() : QDateTime::fromMSecsSinceEpoch(ms); }
+
+private:
+    static constexpr int kMinTombstonesForCompaction = 1024;
+
+    void writeRow(Handle handle, const Order& order);
+    /**
+     * @brief 字符串 ID -> Handle 列表（行号桶）
+     *
+     * 删除与改键都不从桶中间移除元素（那是 O(桶大小) 的移动）：
+     * - 行离开桶时只计数 stale，失效项留在原处
+     * - 键变化后重新加入的行追加到末尾，rows[sorted..] 为乱序部分
+     * 读取前由 settleBucket 一次过滤失效项、排序并去重；失效项超过一半时也立即整理，
+     * 压缩存储时随重映射一起整理。
+     */
+    struct RowBucket {
+        std::vector<Handle> rows;   // [0, sorted) 升序；之后为乱序追加，可能含失效或重复项
+        std::size_t sorted = 0;
+        std::size_t stale = 0;      // 离开本桶后尚未过滤的项数
+
+        bool isSettled() const { return stale == 0 && sorted == rows.size(); }
+    };
+    using RowBuckets = QHash<StringPool::Id, RowBucket>;
+
+    static constexpr std::size_t kMinStaleForSettle = 64;
+
+    static void addToBucket(RowBuckets& buckets, StringPool::Id key, Handle handle);
+    void dropFromBucket(RowBuckets& buckets, const std::vector<StringPool::Id>& column, StringPool::Id key) const;
+    const std::vector<Handle>& bucketRows(RowBuckets& buckets, const std::vector<StringPool::Id>& column,
+                                          StringPool::Id key) const;
+    void settleBucket(RowBucket& bucket, const std::vector<StringPool::Id>& column, StringPool::Id key) const;
+    void remapBuckets(RowBuckets& buckets, const std::vector<StringPool::Id>& column, const QVector<Handle>& remap);
+    static void indexTime(TimeIndex& index, qint64 timeMs, Handle handle);
+    static void unindexTime(TimeIndex& index, qint64 timeMs, Handle handle);
+
+    // 列（行号即 Handle）
+    std::vector<QStringView> m_ids;   // 指向 m_idArena，墓碑行为空视图
+    std::vector<StringPool::Id> m_customer;
+    std::vector<StringPool::Id> m_product;
+    std::vector<StringPool::Id> m_status;  // 墓碑行为 StringPool::InvalidId
+    std::vector<qint32> m_quantity;
+    // 64 位列用 std::int64_t，直接交给 order_kernels（qint64 在部分平台上是另一个类型）
+    std::vector<std::int64_t> m_priceMinor;
+    std::vector<std::int64_t> m_lineTotal;  // quantity × priceMinor，墓碑行为 0
+    std::vector<std::int64_t> m_createdAt;
+    std::vector<std::int64_t> m_updatedAt;
+    std::vector<size_t> m_contentHash;  // contentHash(order)
+    std::vector<quint8> m_alive;      // 行是否存活（0 = 墓碑）
+
+    StringArena m_idArena;            // ID 字符内容
+    StringPool m_strings;             // 客户名、产品名、状态的驻留池
+    QHash<QStringView, Handle> m_index;  // 主键索引: id -> Handle（键指向 m_idArena）
+    // 行号桶在 const 查询中按需整理（见 RowBucket），因此为 mutable
+    mutable RowBuckets m_statusIndex;   // 状态索引: status ID -> Handle 列表
+    mutable RowBuckets m_customerRows;  // 客户名 ID -> Handle 列表（搜索用）
+    mutable RowBuckets m_productRows;   // 产品名 ID -> Handle 列表（搜索用）
+    TrigramIndex m_search;            // 客户名/产品名的 trigram 索引
+    TimeIndex m_createdIndex;         // createdAt 时间索引
+    TimeIndex m_updatedIndex;         // updatedAt 时间索引
+    OrderAggregates m_aggregates;     // 实时统计
+    int m_liveCount = 0;
+};
+
+// -----------------------------------------------------------------------------
+// OrderView 内联实现
+// -----------------------------------------------------------------------------
+
+inline QStringView OrderView::idView() const { return m_store->idAt(m_handle); }
+inline QStringView OrderView::customerNameView() const { return m_store->strings().view(m_store->customerIdAt(m_handle)); }
+inline QStringView OrderView::productNameView() const { return m_store->strings().view(m_store->productIdAt(m_handle)); }
+inline QStringView OrderView::statusView() const { return m_store->strings().view(m_store->statusIdAt(m_handle)); }
+inline int OrderView::quantity() const { return m_store->quantityAt(m_handle); }
+inline qint64 OrderView::priceMinor() const { return m_store->priceMinorAt(m_handle); }
+inline qint64 OrderView::totalMinor() const { return m_store->lineTotalAt(m_handle); }
+inline QDateTime OrderView::createdAt() const { return OrderStore::fromMs(m_store->createdAtMs(m_handle)); }
+inline QDateTime OrderView::updatedAt() const { return OrderStore::fromMs(m_store->updatedAtMs(m_handle)); }
+
+} // namespace orders
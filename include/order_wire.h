@@ -0,0 +1,83 @@
+/**
+ * =============================================================================
+ * Order Wire - 订单的传输格式（JSON / CBOR）
+ * =============================================================================
+ *
+ * 整体载入时 JSON 文本解析占了刷新的大部分 CPU 时间。服务器支持时改用 CBOR：
+ *
+ * - 协商：请求带 Accept（见 acceptHeader），按响应的 Content-Type 选择解码器，
+ *   服务器只会返回 JSON 时照常按 JSON 解析
+ * - 字段名映射为小整数键（见 Key），每条订单省去字段名字符串的编码与比较
+ * - 金额直接传最小货币单位（整数），时间传 UTC 毫秒时间戳，
+ *   解码时没有浮点转换与 ISO 8601 解析
+ *
+ * CBOR 响应体是一个数组（定长或不定长），每个元素是以 Key 为键的 map，
+ * 未知的键与类型不符的值被跳过。
+ *
+ * 增量解码见 order_ingest.h 的 OrderCborStream。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "order.h"
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+
+class QCborStreamWriter;
+
+namespace orders::wire {
+
+/**
+ * @brief CBOR map 中的字段键
+ *
+ * 数值是协议的一部分，只能追加，不能修改或复用
+ */
+enum class Key : quint8 {
+    Id = 0,
+    CustomerName = 1,
+    ProductName = 2,
+    Quantity = 3,
+    PriceMinor = 4,     // 单价（分，整数）
+    Status = 5,
+    CreatedAt = 6,      // UTC 毫秒时间戳
+    UpdatedAt = 7,
+};
+
+inline constexpr char kJsonMimeType[] = "application/json";
+inline constexpr char kCborMimeType[] = "application/cbor";
+
+/**
+ * @brief 请求的 Accept 头
+ * @param preferCbor true 时优先 CBOR、JSON 作为回退；false 时只接受 JSON
+ */
+QString acceptHeader(bool preferCbor);
+
+/**
+ * @brief 按响应的 Content-Type 判断是否为 CBOR（忽略参数与大小写）
+ */
+bool isCbor(const QByteArray& contentType);
+
+/**
+ * @brief 写出一条订单（以 Key 为键的 map）
+ */
+void writeOrder(QCborStreamWriter& writer, const Order& order);
+
+/**
+ * @brief 把订单编码为 CBOR 数组（测试数据、基准测试与服务端参考实现使用）
+ */
+QByteArray encodeCbor(const QList<Order>& orders);
+
+/**
+ * @brief 与 Order::fromJson 对应的 JSON 对象
+ */
+QJsonObject toJson(const Order& order);
+
+/**
+ * @brief 把订单编码为 JSON 数组（紧凑格式）
+ */
+QByteArray encodeJson(const QList<Order>& orders);
+
+} // namespace orders::wire
@@ -33,6 +33,7 @@ namespace orders {
 // 前向声明 - 【修改点2】改为你的服务类名
 class OrdersService;
 class DemoService;
+class RefreshScheduler;
 
 /**
  * @brief 订单管理插件主类
@@ -43,7 +44,7 @@ class DemoService;
  * - QML 类型注册 (qmlRegisterSingletonInstance, qmlRegisterType)
  * - 路由注册 (INavigation::registerRoute)
  * - 菜单项注册 (IMenu::registerItem)
- * - 菜单徽章更新 (IMenu::setBadge)
+ * - 菜单徽章更新 (IMenu::setBadge，经 RefreshScheduler 合并、限频)
  * - 使用 MPF 日志系统 (MPF_LOG_xxx)
  * 
  * 【创建新插件清单】
@@ -155,9 +156,13 @@ private:
      */
     void registerQmlTypes();
 
+    // 派生 UI 状态每秒最多刷新的次数
+    static constexpr int kRefreshMaxHz = 10;
+
     mpf::ServiceRegistry* m_registry = nullptr;          // 服务注册表引用
     std::unique_ptr<OrdersService> m_ordersService;      // 【修改点6】业务服务实例
     std::unique_ptr<DemoService> m_demoService;          // Demo service for framework showcase
+    std::unique_ptr<RefreshScheduler> m_refreshScheduler; // 徽章、统计等派生 UI 状态的刷新调度（先于服务销毁）
 };
 
 } // namespace orders
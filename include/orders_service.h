@@ -25,10 +25,22 @@
 
 #pragma once
 
+#include "order.h"
+#include "order_change_set.h"
+#include "order_id_generator.h"
+#include "order_store.h"
+#include "refresh_scheduler.h"
+
 #include <QObject>
+#include <QPointer>
+#include <QHash>
 #include <QList>
+#include <QSet>
+#include <QStringList>
 #include <QVariantMap>
 #include <QDateTime>
+#include <QVector>
+#include <functional>
 #include <memory>
 
 // MPF HTTP 客户端前向声明
@@ -37,47 +49,24 @@ namespace mpf::http {
 class HttpClient;
 }
 
+class QNetworkReply;
+class QThread;
+
 // 【修改点1】命名空间
 namespace orders {
 
-// =============================================================================
-// 数据结构定义
-// =============================================================================
+class OrderIngestWorker;
+class ResponseCache;
 
 /**
- * @brief 订单数据结构
- * 
- * 【修改点2】根据你的业务需求定义数据字段
- * 
- * 设计建议：
- * - 使用 QString 而不是 std::string（Qt 生态兼容性）
- * - 使用 QDateTime 处理时间
- * - 提供 toVariantMap/fromVariantMap 用于 QML 交互
+ * @brief 服务器返回的一页订单（fetchOrdersPage 的结果）
  */
-struct Order {
-    QString id;              // 唯一标识符
-    QString customerName;    // 客户名称
-    QString productName;     // 产品名称
-    int quantity;            // 数量
-    double price;            // 单价
-    QString status;          // 状态: pending, processing, shipped, delivered, cancelled
-    QDateTime createdAt;     // 创建时间
-    QDateTime updatedAt;     // 更新时间
-    
-    /**
-     * @brief 转换为 QVariantMap
-     * 
-     * 用于将 C++ 结构体传递给 QML
-     * QML 中可以直接访问属性：order.customerName, order.price 等
-     */
-    QVariantMap toVariantMap() const;
-    
-    /**
-     * @brief 从 QVariantMap 创建
-     * 
-     * 用于从 QML 传入的数据创建 C++ 对象
-     */
-    static Order fromVariantMap(const QVariantMap& map);
+struct OrderPage
+{
+    bool ok = false;
+    QString error;          // ok 为 false 时的错误信息
+    int total = -1;         // 服务器给出的匹配总数，-1 表示未知
+    QVector<Order> orders;
 };
 
 // =============================================================================
@@ -125,6 +114,15 @@ class OrdersService : public QObject
 {
     Q_OBJECT
 
+    // =========================================================================
+    // 实时统计属性
+    // 由 OrderStore 在每次增删改时 O(1) 维护，QML 绑定后随 statsChanged 自动刷新，
+    // 无需反复调用 getOrderCount()/getTotalRevenue()
+    // =========================================================================
+    Q_PROPERTY(int orderCount READ getOrderCount NOTIFY statsChanged)
+    Q_PROPERTY(double totalRevenue READ getTotalRevenue NOTIFY statsChanged)
+    Q_PROPERTY(QVariantMap statusSummary READ statusSummary NOTIFY statsChanged)
+
 public:
     explicit OrdersService(QObject* parent = nullptr);
     ~OrdersService() override;
@@ -201,6 +199,54 @@ public:
      */
     Q_INVOKABLE bool updateStatus(const QString& id, const QString& status);
     
+    // =========================================================================
+    // 批量操作
+    // 批处理期间不发出单条信号（orderCreated 等），
+    // 结束时只发出一次 orderChanges（合并后的变更集）和一次 ordersChanged
+    // =========================================================================
+    
+    /**
+     * @brief 批量创建订单
+     * @param list 订单数据列表（格式同 createOrder）
+     * @return 新订单的 ID 列表，与 list 一一对应
+     * 
+     * QML 使用示例：
+     * @code{.qml}
+     * var ids = OrdersService.createOrders([
+     *     { customerName: "A", productName: "X", quantity: 1, price: 9.9 },
+     *     { customerName: "B", productName: "Y", quantity: 2, price: 5.0 }
+     * ])
+     * @endcode
+     */
+    Q_INVOKABLE QStringList createOrders(const QVariantList& list);
+    
+    /**
+     * @brief 批量更新订单
+     * @param updates 订单 ID -> 要更新的字段（格式同 updateOrder）
+     * @return 实际更新的订单数
+     */
+    Q_INVOKABLE int updateOrders(const QVariantMap& updates);
+    
+    /**
+     * @brief 批量删除订单
+     * @return 实际删除的订单数
+     */
+    Q_INVOKABLE int deleteOrders(const QStringList& ids);
+    
+    /**
+     * @brief 开始 / 结束批处理作用域（可嵌套，最外层 endBatch() 时发出变更）
+     * 
+     * 用于组合多种操作，例如：
+     * @code{.qml}
+     * OrdersService.beginBatch()
+     * OrdersService.updateStatus(a, "shipped")
+     * OrdersService.deleteOrder(b)
+     * OrdersService.endBatch()
+     * @endcode
+     */
+    Q_INVOKABLE void beginBatch();
+    Q_INVOKABLE void endBatch();
+    
     /**
      * @brief 按状态筛选订单
      * @param status 状态值
@@ -220,6 +266,92 @@ public:
      */
     Q_INVOKABLE double getTotalRevenue() const;
     
+    /**
+     * @brief 获取各状态统计
+     * @return QVariantMap { status: { count, revenue } }
+     * 
+     * QML 使用示例：
+     * @code{.qml}
+     * Label { text: (OrdersService.statusSummary.pending || {}).count || 0 }
+     * @endcode
+     */
+    QVariantMap statusSummary() const;
+    
+    /**
+     * @brief 获取收入分布统计
+     * @param status 状态值，为空时统计所有订单
+     * @return QVariantMap { count, sum, min, max, average }，min/max 为单笔订单金额
+     */
+    Q_INVOKABLE QVariantMap getRevenueStats(const QString& status = QString()) const;
+    
+    // =========================================================================
+    // 时间范围查询
+    // 基于 createdAt / updatedAt 时间索引，O(log n + k)
+    // =========================================================================
+    
+    /**
+     * @brief 获取创建时间在 [from, to) 内的订单，按创建时间升序
+     * @param from 起始时间（包含），无效时间表示不限
+     * @param to 结束时间（不包含），无效时间表示不限
+     * 
+     * QML 使用示例（最近一小时创建的订单）：
+     * @code{.qml}
+     * var orders = OrdersService.getOrdersCreatedBetween(
+     *     new Date(Date.now() - 3600 * 1000), new Date())
+     * @endcode
+     */
+    Q_INVOKABLE QVariantList getOrdersCreatedBetween(const QDateTime& from, const QDateTime& to) const;
+    
+    /**
+     * @brief 获取更新时间在 [from, to) 内的订单，按更新时间升序
+     */
+    Q_INVOKABLE QVariantList getOrdersUpdatedBetween(const QDateTime& from, const QDateTime& to) const;
+    
+    /**
+     * @brief 获取 since（包含）之后更新过的订单，按更新时间升序
+     */
+    Q_INVOKABLE QVariantList getOrdersUpdatedSince(const QDateTime& since) const;
+    
+    // =========================================================================
+    // 搜索
+    // 基于客户名/产品名的 trigram 倒排索引，随增删改增量维护
+    // =========================================================================
+    
+    /**
+     * @brief 按客户名或产品名子串搜索订单（忽略大小写）
+     * @param query 查询串，空串返回空列表
+     * @param limit 最多返回的条数，<= 0 表示不限
+     * @return 匹配的订单列表，按创建顺序
+     * 
+     * QML 使用示例：
+     * @code{.qml}
+     * var hits = OrdersService.search("widget", 20)
+     * @endcode
+     */
+    Q_INVOKABLE QVariantList search(const QString& query, int limit = 50) const;
+    
+    // =========================================================================
+    // 分页查询
+    // 筛选、排序、分页全部在 C++ 中完成，只物化请求的那一页
+    // =========================================================================
+    
+    /**
+     * @brief 按条件查询订单的一页
+     * @param query {filter, sortBy, descending, offset, limit}，格式见 order_query.h
+     * @return {orders: 当前页订单列表, total: 匹配总数, offset, limit}
+     * 
+     * QML 使用示例（金额最高的 20 个待处理订单）：
+     * @code{.qml}
+     * var page = OrdersService.queryOrders({
+     *     filter: { status: "pending" },
+     *     sortBy: "total", descending: true,
+     *     offset: 0, limit: 20
+     * })
+     * console.log(page.total, page.orders.length)
+     * @endcode
+     */
+    Q_INVOKABLE QVariantMap queryOrders(const QVariantMap& query) const;
+    
     // =========================================================================
     // HTTP 网络操作
     // 【MPF HTTP 客户端使用示例】
@@ -236,6 +368,27 @@ public:
      * 3. 处理异步响应
      * 4. 解析 JSON 数据
      * 
+     * 【流式载入】
+     * 响应按 readyRead 分段交给工作线程上的 OrderIngestWorker 解析，
+     * GUI 线程只负责把解析好的订单按批（每批 1000 条）写入存储，每批发出 fetchProgress：
+     * - 本地为空（冷启动）：逐批追加，每批作为一次变更发出
+     * - 本地已有数据：按 ID 合并。内容哈希相同的行跳过，变化的行原地更新，
+     *   新订单插入；载入完整结束后，响应中没有的订单被删除。
+     *   每批只发出变化的行，缺失订单的删除在结束时作为一个变更集发出，
+     *   未变化行的 Handle、模型选中状态都保留
+     * - 第一批之前出错（网络错误、非数组响应）原有数据保持不变；
+     *   之后出错则保留已合并的部分（不删除任何订单），同样以 fetchCompleted(false, ...) 报告
+     * - 再次调用会中止尚未完成的上一次抓取
+     * 
+     * 【传输格式】（见 setPreferCbor）
+     * 请求带 Accept 协商 CBOR（整数字段键，见 order_wire.h），
+     * 响应为 application/cbor 时用 OrderCborStream 解码，否则按 JSON 数组解析
+     * 
+     * 【响应缓存】（见 setResponseCache）
+     * 缓存新鲜时直接从缓存载入；过期但在 stale-while-revalidate 窗口内时，
+     * 先从缓存载入（fetchCompleted: "Loaded N cached orders"），
+     * 同时发出条件请求，304 时再发出一次 fetchCompleted("Up to date")，200 时按 ID 合并新数据
+     * 
      * QML 使用示例：
      * @code{.qml}
      * OrdersService.fetchOrdersFromServer("https://api.example.com/orders")
@@ -253,6 +406,136 @@ public:
      * @endcode
      */
     Q_INVOKABLE void fetchOrdersFromServer(const QString& apiUrl);
+    
+    /**
+     * @brief 增量同步：只拉取上次同步之后的变化
+     * @param apiUrl API 地址
+     * 
+     * 与 fetchOrdersFromServer 的整体替换不同，同步只新增/更新/删除变化的订单，
+     * 稳态下的开销与变化量成正比，而不是与订单总数成正比。
+     * 
+     * 【协议】
+     * 请求：GET apiUrl?since=<cursor>，并带 If-None-Match: <ETag>
+     * （首次同步两者都不带，服务器返回全部订单）
+     * - 304 Not Modified: 没有变化
+     * - 200: {"orders": [...], "deleted": ["id", ...], "cursor": "..."}
+     *   - orders: 新增或变化的订单，按 ID 新增或整条覆盖（内容相同的跳过）
+     *   - deleted: 已删除的订单 ID
+     *   - cursor: 下次同步的游标；缺省时以收到订单的最大 updatedAt 作为水位
+     *   也可以直接返回订单数组（只有新增/更新）
+     * 响应成功应用后记住其 ETag 头（在发出 syncCompleted 之前），用于下次的 If-None-Match；
+     * 无法解析的响应不会更新游标与 ETag，下次同步重新请求同一段变化。
+     * 
+     * 服务器按 updatedAt >= since 返回即可：重复收到的订单内容相同，不会产生变更。
+     * 所有变化合并为一个变更集发出，结果通过 syncCompleted 通知。
+     * 同一地址的同步进行中时再次调用会被忽略；换用其他地址时游标重新开始。
+     */
+    Q_INVOKABLE void syncOrders(const QString& apiUrl);
+    
+    /**
+     * @brief 丢弃同步游标与 ETag，下次 syncOrders 重新拉取全部订单
+     * 
+     * fetchOrdersFromServer 开始写入载入结果时（冷载入清空或按 ID 合并）也会调用：
+     * 整体载入之后，旧游标不再对应本地数据
+     */
+    Q_INVOKABLE void resetSync();
+    
+    static constexpr int kDefaultBulkPageSize = 500;
+    static constexpr int kDefaultMaxInFlight = 4;
+    
+    /**
+     * @brief 分页并发的整体载入
+     * @param apiUrl 分页 API 地址（与 fetchOrdersPage 相同的 offset/limit 协议）
+     * @param pageSize 每页订单数
+     * @param maxInFlight 同时进行的页请求上限
+     * 
+     * 与 fetchOrdersFromServer 一样载入完整数据（冷启动追加，已有数据时按 ID 合并），区别是按页拉取：
+     * 1. 先请求第一页，由响应中的 total 得到页数
+     * 2. 其余页通过 HttpClient 并发请求，同时最多 maxInFlight 个
+     * 3. 各页可能乱序到达，按页序依次写入存储（后面的页先到时等待前面的页）
+     * 冷启动耗时约为最慢几页的耗时，而不是所有页耗时之和。
+     * 
+     * 服务器不给 total（返回纯数组）时，按 maxInFlight 的窗口预取，
+     * 遇到不满一页的响应即视为末页。
+     * 进度与结果同样通过 fetchProgress / fetchCompleted 通知；
+     * 与 fetchOrdersFromServer 互相取代，任一页失败则放弃其余页。
+     * QNetworkAccessManager 对同一主机最多并行 6 个 HTTP/1.1 连接，更大的 maxInFlight 只会排队。
+     */
+    Q_INVOKABLE void fetchAllOrdersPaged(const QString& apiUrl, int pageSize = kDefaultBulkPageSize,
+                                         int maxInFlight = kDefaultMaxInFlight);
+    
+    using PageCallback = std::function<void(const OrderPage& page)>;
+    
+    /**
+     * @brief 从服务器获取一页订单（不写入本地存储）
+     * @param apiUrl API 地址
+     * @param params 额外的查询参数（如 status、q），原样拼到 URL 上
+     * @param offset 起始行
+     * @param limit 页大小
+     * @param context 回调的生命周期对象，销毁后不再回调
+     * @param callback 完成回调（在主线程调用）
+     * 
+     * 请求形如 GET apiUrl?offset=200&limit=100&status=pending。
+     * 响应可以是 {"total": N, "orders": [...]}，也可以是纯数组（总数未知）。
+     * URL 完全相同的请求进行中时不再发出新请求，而是共享同一个 reply 的结果。
+     * 供 OrderModel 的分页模式使用，C++ 接口，不暴露给 QML
+     */
+    void fetchOrdersPage(const QString& apiUrl, const QVariantMap& params, int offset, int limit,
+                         QObject* context, PageCallback callback);
+    
+    /**
+     * @brief 取消 context 发起的所有页请求
+     * 
+     * 这些请求不再回调；没有其他等待方的请求被中止。
+     * 筛选条件或数据源变化后，调用方借此中止已过时的请求
+     */
+    void cancelOrdersPages(QObject* context);
+    
+    // =========================================================================
+    // 扩展点
+    // =========================================================================
+    
+    /**
+     * @brief 替换订单 ID 生成器
+     * @param generator 新的生成器，传入 nullptr 时恢复默认的 SnowflakeIdGenerator
+     * 
+     * 默认生成器使用随机节点号；多实例部署时可传入固定节点号的生成器，
+     * 例如 std::make_unique<SnowflakeIdGenerator>(instanceIndex)
+     */
+    void setIdGenerator(std::unique_ptr<OrderIdGenerator> generator);
+    
+    /**
+     * @brief 通过刷新调度器发出 statsChanged
+     * @param scheduler 插件持有的调度器，传入 nullptr 时恢复为每次变化立即通知
+     * 
+     * 批量导入、整体加载时统计属性不必随每次变化刷新，
+     * 交给调度器合并、限频后 QML 的统计卡片只取最新值
+     */
+    void setRefreshScheduler(RefreshScheduler* scheduler);
+    
+    /**
+     * @brief 设置 HTTP 响应缓存（插件与 DemoService 共用同一个）
+     * @param cache 传入 nullptr 时不使用缓存
+     * 
+     * fetchOrdersFromServer 与 fetchOrdersPage 经过缓存：新鲜的响应不再请求服务器，
+     * 过期的响应带验证器发出条件请求。syncOrders 的增量响应不缓存
+     */
+    void setResponseCache(std::shared_ptr<ResponseCache> cache);
+    
+    /**
+     * @brief 整体载入是否请求 CBOR 响应（默认 true）
+     * 
+     * true 时 fetchOrdersFromServer 发送 Accept: application/cbor, application/json;q=0.9，
+     * 响应按 Content-Type 解码，服务器只返回 JSON 时照常解析。
+     * 格式见 order_wire.h
+     */
+    void setPreferCbor(bool prefer);
+    bool preferCbor() const { return m_preferCbor; }
+    
+    /**
+     * @brief 只读访问订单存储（供 C++ 侧的模型按 Handle 读取列，不暴露给 QML）
+     */
+    const OrderStore& store() const { return m_store; }
 
     // =========================================================================
     // 信号定义
@@ -297,22 +580,199 @@ signals:
      */
     void ordersChanged();
     
+    /**
+     * @brief 细粒度变更信号
+     * @param changes 本次操作插入/更新/删除的订单及更新涉及的字段
+     * 
+     * 先于 orderCreated / orderUpdated / orderDeleted 与 ordersChanged 发出，
+     * 这些信号的处理函数读取模型时，模型已与存储同步。
+     * OrderModel 据此做增量的行插入/删除/dataChanged，而不是整体重置
+     */
+    void orderChanges(const orders::OrderChangeSet& changes);
+    
+    /**
+     * @brief 带增量的单条变更事件
+     * @param event 序号 + 类型 + 变化字段的旧值/新值（见 order_event.h）
+     * 
+     * 紧随 orderCreated / orderUpdated / orderDeleted 发出，
+     * 监听方无需再调用 getOrder() 查询变化内容。
+     * 批处理期间不逐条发出，事件按序号收在 orderChanges 的 changes.events 中
+     */
+    void orderEvent(const orders::OrderEvent& event);
+    
     /**
      * @brief 网络请求完成信号
      * @param success 是否成功
      * @param message 结果消息
      */
     void fetchCompleted(bool success, const QString& message);
+    
+    /**
+     * @brief 流式载入进度信号（fetchOrdersFromServer 每写入一批订单发出一次）
+     * @param bytesReceived 已接收的字节数
+     * @param bytesTotal 响应总字节数，未知时为 -1
+     * @param ordersLoaded 已写入存储的订单数
+     */
+    void fetchProgress(qint64 bytesReceived, qint64 bytesTotal, int ordersLoaded);
+    
+    /**
+     * @brief 增量同步完成信号
+     * @param success 是否成功
+     * @param upserted 新增或更新的订单数
+     * @param deleted 删除的订单数
+     * @param message 结果消息
+     */
+    void syncCompleted(bool success, int upserted, int deleted, const QString& message);
+    
+    /**
+     * @brief 统计数据变化信号
+     * 
+     * orderCount / totalRevenue / statusSummary 属性的 NOTIFY 信号，
+     * 与 ordersChanged 同步发出
+     */
+    void statsChanged();
 
 private:
     /**
      * @brief 生成唯一 ID
-     * @return QString 8 位 UUID
+     * @return QString 由 m_idGenerator 生成的 ID（默认 13 位、按创建时间有序）
      */
     QString generateId() const;
     
-    QList<Order> m_orders;                               // 订单数据存储
+    /**
+     * @brief 将 Handle 列表转换为 QVariantList
+     */
+    QVariantList toVariantList(const std::vector<OrderStore::Handle>& handles) const;
+    
+    /**
+     * @brief 需要时压缩存储，并发出累积的变更（orderChanges + ordersChanged）
+     * @return 刚发出的变更集
+     */
+    OrderChangeSet commitChanges();
+    
+    /**
+     * @brief 按 ID 新增或整条覆盖一个来自服务器的订单，记录变更与事件
+     * @return 是否产生了变化（内容完全相同时返回 false）
+     * 
+     * 只累积变更，由调用方 commitChanges()（通常在批处理中调用）
+     */
+    bool upsertOrder(const Order& order);
+    
+    /**
+     * @brief 解析一页订单的响应（fetchOrdersPage）
+     */
+    static OrderPage parseOrdersPage(const QByteArray& body);
+    
+    /**
+     * @brief 应用一次同步响应（在批处理中新增/更新/删除）并推进游标
+     * @param upserted 新增或更新的订单数
+     * @param removed 删除的订单数
+     * @return 响应无法解析时返回 false，数据与游标保持不变
+     */
+    bool applySyncResponse(const QByteArray& body, int* upserted, int* removed);
+    
+    /**
+     * @brief 把缓存的响应体交给工作线程载入（本次载入的缓存阶段）
+     */
+    void ingestCached(quint64 generation, const QByteArray& body, const QByteArray& contentType);
+    
+    /**
+     * @brief 启动流式解析工作线程（首次抓取时创建）
+     */
+    void ensureIngestWorker();
+    
+    /**
+     * @brief 写入工作线程交回的一批订单（GUI 线程）
+     */
+    void applyFetchedBatch(quint64 generation, const QList<orders::Order>& orders);
+    
+    /**
+     * @brief 在并发上限内为分页载入发出更多页请求
+     */
+    void requestFetchPages(quint64 generation);
+    
+    /**
+     * @brief 分页载入的一页到达：缓存，按页序合并，全部完成时结束本次载入
+     */
+    void onFetchPage(quint64 generation, int page, const OrderPage& result);
+    
+    /**
+     * @brief 整体载入的第一批到达：决定追加（本地为空）还是合并
+     */
+    void beginFetchApply();
+    
+    /**
+     * @brief 开始一次整体载入：中止进行中的载入，换用新的编号
+     * @return 新载入的编号，旧编号的回调、批次和页都会被丢弃
+     */
+    quint64 startFetch(const QString& apiUrl);
+    
+    /**
+     * @brief 放弃进行中的分页载入，中止其尚未完成的页请求
+     */
+    void cancelPagedFetch();
+    
+    /**
+     * @brief 整体载入失败：放弃其余部分，发出已合并的变化与 fetchCompleted(false)
+     */
+    void failFetch(const QString& error);
+    
+    /**
+     * @brief 载入结束：合并模式下删除响应中没有的订单，发出 fetchCompleted
+     */
+    void finishFetch(quint64 generation, bool ok, const QString& error, int total);
+    
+    static constexpr const char* kStatsRefreshTask = "orders.stats";
+    bool inBatch() const { return m_batchDepth > 0; }
+    
+    OrderStore m_store;                                  // 列式订单存储（字符串驻留/ID 块、索引桶、聚合，见 order_store.h）
     std::unique_ptr<mpf::http::HttpClient> m_httpClient; // HTTP 客户端实例
+    std::unique_ptr<OrderIdGenerator> m_idGenerator;     // 订单 ID 生成器
+    QPointer<RefreshScheduler> m_refreshScheduler;       // statsChanged 的刷新调度器（可选，不持有）
+    std::shared_ptr<ResponseCache> m_responseCache;      // HTTP 响应缓存（可选）
+    bool m_preferCbor = true;                            // 整体载入优先请求 CBOR
+    OrderChangeBuilder m_changes;                        // 尚未发出的变更（批处理期间累积）
+    int m_batchDepth = 0;                                // beginBatch() 嵌套深度
+    qint64 m_eventSequence = 0;                          // 最近一个 OrderEvent 的序号
+    
+    // 流式载入（fetchOrdersFromServer）
+    QThread* m_ingestThread = nullptr;                   // 解析工作线程
+    OrderIngestWorker* m_ingestWorker = nullptr;         // 运行在 m_ingestThread 上
+    QPointer<QNetworkReply> m_fetchReply;                // 进行中的抓取请求
+    QString m_fetchUrl;                                  // 进行中的整体载入地址，空表示没有
+    QByteArray m_fetchCacheKey;                          // 本次载入的响应缓存键
+    QByteArray m_fetchBody;                              // 网络响应体（结束时写入缓存）
+    bool m_fetchFromCache = false;                       // 工作线程正在解析缓存的响应体
+    bool m_fetchCacheServed = false;                     // 缓存数据已载入，等待后台条件请求
+    bool m_fetchCacheStored = false;                     // 本次的网络响应已写入缓存（比正在解析的缓存更新）
+    bool m_fetchNetwork = false;                         // 网络请求尚未结束
+    bool m_fetchStreamStarted = false;                   // 网络响应体已开始交给工作线程
+    quint64 m_fetchGeneration = 0;                       // 当前抓取的编号，旧编号的批次被丢弃
+    bool m_fetchApplied = false;                         // 本次载入已开始写入（已选定冷载入清空或按 ID 合并）
+    qint64 m_fetchBytes = 0;                             // 已接收字节数
+    qint64 m_fetchBytesTotal = -1;                       // 响应总字节数，未知时为 -1
+    int m_fetchLoaded = 0;                               // 已写入的订单数
+    bool m_fetchMerge = false;                           // 按 ID 合并（本地已有数据时）
+    QSet<QString> m_fetchSeen;                           // 合并模式下本次载入出现过的 ID
+    struct PagedFetch;
+    std::unique_ptr<PagedFetch> m_pagedFetch;            // 进行中的分页载入（fetchAllOrdersPaged）
+    
+    // 进行中的页请求（fetchOrdersPage），按完整 URL 共享
+    struct PageWaiter {
+        QPointer<QObject> context;
+        PageCallback callback;
+    };
+    struct PageRequest {
+        QPointer<QNetworkReply> reply;
+        QList<PageWaiter> waiters;
+    };
+    QHash<QString, PageRequest> m_pageRequests;
+    
+    // 增量同步（syncOrders）
+    QString m_syncUrl;                                   // 游标所属的 API 地址
+    QString m_syncCursor;                                // 下次请求的 since 参数
+    QString m_syncEtag;                                  // 上次响应的 ETag
+    QPointer<QNetworkReply> m_syncReply;                 // 进行中的同步请求
 };
 
 } // namespace orders
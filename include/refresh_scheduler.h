@@ -0,0 +1,82 @@
+/**
+ * =============================================================================
+ * Refresh Scheduler - 合并 + 限频的刷新调度器
+ * =============================================================================
+ *
+ * 派生 UI 状态（菜单徽章、统计卡片等）只关心“最新值”，不需要对每次数据变化都刷新。
+ * 调度器按键登记刷新任务，request(key) 只把任务标记为待执行：
+ * - 合并：两次执行之间的多次 request 只执行一次
+ * - 限频：同一调度器的执行间隔不小于 1000 / maxHz 毫秒
+ * - 取最新值：任务在执行时才读取当前状态，而不是捕获请求时的值
+ *
+ * 即使不限频（maxHz <= 0），同一轮事件循环内的请求也会合并到下一轮执行。
+ *
+ * 【使用示例】
+ * @code
+ * scheduler->addTask("badge", [=] { menu->setBadge("orders", QString::number(service->getOrderCount())); });
+ * connect(service, &OrdersService::ordersChanged, scheduler, [=] { scheduler->request("badge"); });
+ * @endcode
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <functional>
+
+namespace orders {
+
+class RefreshScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultMaxHz = 10;
+
+    explicit RefreshScheduler(int maxHz = kDefaultMaxHz, QObject* parent = nullptr);
+    ~RefreshScheduler() override;
+
+    /**
+     * @brief 每秒最多执行的次数，<= 0 表示不限频（仍按事件循环合并）
+     */
+    int maxHz() const { return m_maxHz; }
+    void setMaxHz(int hz);
+
+    /**
+     * @brief 登记刷新任务（同名任务被替换）
+     */
+    void addTask(const QString& key, std::function<void()> task);
+    void removeTask(const QString& key);
+
+    /**
+     * @brief 标记任务待执行（未登记的键忽略）
+     */
+    void request(const QString& key);
+
+    /**
+     * @brief 立即执行所有待执行的任务（如插件停止前）
+     */
+    void flush();
+
+    bool hasPending() const { return m_timer.isActive(); }
+
+private:
+    struct Task {
+        std::function<void()> run;
+        bool pending = false;
+    };
+
+    void schedule();
+    void runPending();
+
+    QHash<QString, Task> m_tasks;
+    QTimer m_timer;                 // 单次定时器，到期执行所有待执行任务
+    QElapsedTimer m_sinceLastRun;   // 距上次执行的时间，用于计算下一次的延迟
+    int m_maxHz;
+};
+
+} // namespace orders
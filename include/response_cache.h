@@ -0,0 +1,134 @@
+/**
+ * =============================================================================
+ * Response Cache - 持久化的 HTTP 响应缓存
+ * =============================================================================
+ *
+ * 插件每次启动、每次刷新都会重新请求大多没有变化的数据。ResponseCache 把
+ * GET 响应保存在磁盘上，供 OrdersService / DemoService 在调用 HttpClient 前后使用：
+ *
+ * - 键：URL + 请求头（见 key()），内容协商不同的请求互不混淆
+ * - 验证器：保存 ETag / Last-Modified，过期后发出条件请求
+ *   （If-None-Match / If-Modified-Since），304 时沿用缓存的响应体
+ * - Cache-Control：max-age（或 Expires）决定新鲜期，no-store 不缓存，
+ *   no-cache / must-revalidate 每次使用前必须重新验证
+ * - stale-while-revalidate：过期但仍在窗口内的响应可以先交给界面，
+ *   同时在后台发出条件请求。服务器未给出该指令时，调用方可以在 store()/refresh()
+ *   时给出缺省窗口：OrdersService 使用 kDefaultStaleWhileRevalidate，使订单页在启动时
+ *   就能从缓存立即显示；DemoService 是诊断工具，不使用缺省窗口
+ *
+ * 每个条目是缓存目录下的一个文件（QSaveFile 原子写入），总大小超过 maxBytes 时
+ * 淘汰最久未写入的条目。只在 GUI 线程使用。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QUrl>
+
+class QNetworkReply;
+
+namespace orders {
+
+class ResponseCache
+{
+public:
+    /**
+     * @brief 一条缓存的响应
+     */
+    struct Entry {
+        int status = 0;                     // 0 表示没有缓存
+        QByteArray body;
+        QByteArray contentType;
+        QByteArray etag;
+        QByteArray lastModified;
+        QDateTime storedAt;                 // 最近一次写入或验证的时间（UTC）
+        qint64 maxAge = 0;                  // 新鲜期（秒）
+        qint64 staleWhileRevalidate = 0;    // 过期后仍可先使用的时长（秒）
+        bool noCache = false;               // 使用前必须重新验证
+
+        bool isValid() const { return status != 0; }
+        bool hasValidators() const { return !etag.isEmpty() || !lastModified.isEmpty(); }
+
+        /**
+         * @brief 仍在新鲜期内，可以直接使用而不请求服务器
+         */
+        bool isFresh(const QDateTime& now) const;
+
+        /**
+         * @brief 已过期但可以先使用，同时在后台重新验证
+         */
+        bool canServeStale(const QDateTime& now) const;
+    };
+
+    using Headers = QList<QPair<QString, QString>>;
+
+    static constexpr qint64 kDefaultMaxBytes = 64ll * 1024 * 1024;
+    static constexpr qint64 kDefaultStaleWhileRevalidate = 24 * 3600;  // 订单数据的缺省窗口
+
+    /**
+     * @param directory 缓存目录，不存在时自动创建
+     * @param maxBytes 所有条目的总大小上限
+     */
+    explicit ResponseCache(const QString& directory = defaultDirectory(), qint64 maxBytes = kDefaultMaxBytes);
+
+    /**
+     * @brief 默认缓存目录：QStandardPaths::CacheLocation 下的 orders-http
+     */
+    static QString defaultDirectory();
+
+    /**
+     * @brief 缓存键：URL 与（按名称排序的）请求头的 SHA-1
+     */
+    static QByteArray key(const QUrl& url, const QMap<QString, QString>& headers = {});
+
+    /**
+     * @brief 读取缓存条目，没有时返回 isValid() 为 false 的 Entry
+     */
+    Entry lookup(const QByteArray& key) const;
+
+    /**
+     * @brief 保存 200 响应
+     * @param body 完整响应体（reply 的数据可能已被流式读取，由调用方传入）
+     * @param defaultStaleWhileRevalidate 服务器未给出 stale-while-revalidate 时使用的窗口（秒）
+     * @return 是否保存（非 200、no-store 时不保存）
+     */
+    bool store(const QByteArray& key, QNetworkReply* reply, const QByteArray& body,
+               qint64 defaultStaleWhileRevalidate = 0);
+
+    /**
+     * @brief 304 响应：按新的响应头更新验证器与新鲜期，响应体保持不变
+     * @param defaultStaleWhileRevalidate 同 store()
+     * @return 更新后的条目；缓存中没有该键时返回无效 Entry
+     */
+    Entry refresh(const QByteArray& key, QNetworkReply* notModified, qint64 defaultStaleWhileRevalidate = 0);
+
+    void remove(const QByteArray& key);
+    void clear();
+
+    /**
+     * @brief 条件请求头（If-None-Match / If-Modified-Since）
+     */
+    static Headers conditionalHeaders(const Entry& entry);
+
+    /**
+     * @brief 响应是否为 304 Not Modified
+     */
+    static bool isNotModified(QNetworkReply* reply);
+
+private:
+    QString pathFor(const QByteArray& key) const;
+    bool write(const QByteArray& key, const Entry& entry);
+    static void applyCacheControl(QNetworkReply* reply, Entry& entry, qint64 defaultStaleWhileRevalidate);
+    void evict();
+
+    QString m_directory;
+    qint64 m_maxBytes;
+};
+
+} // namespace orders
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include "order_query.h"
+#include "orders_service.h"
+
+#include <array>
+#include <vector>
+
+namespace orders {
+
+/**
+ * @brief Sorted, filtered view over the service store
+ *
+ * Rows are store handles ordered by up to kMaxSortKeys keys, e.g.
+ * sortKeys: ["status", "-createdAt", "total"] (a leading '-' sorts that key
+ * descending; ties always fall back to creation order). Supported keys are
+ * the OrderQuery sort keys except "id".
+ *
+ * The view keeps its order under change sets without re-sorting: each
+ * inserted, updated or removed order is located by binary search on a
+ * snapshot of its sort-key values, updates whose keys changed are moved
+ * with beginMoveRows, and other updates only emit dataChanged for the
+ * affected roles. Change sets above resetThreshold rebuild the view.
+ *
+ * Roles are the same as OrderModel's, so delegates can be shared.
+ */
+class SortedOrderModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(QStringList sortKeys READ sortKeys WRITE setSortKeys NOTIFY sortKeysChanged)
+    Q_PROPERTY(QString filterStatus READ filterStatus WRITE setFilterStatus NOTIFY filterStatusChanged)
+    Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
+    Q_PROPERTY(int resetThreshold READ resetThreshold WRITE setResetThreshold NOTIFY resetThresholdChanged)
+    Q_PROPERTY(orders::OrdersService* service READ service WRITE setService NOTIFY serviceChanged)
+
+public:
+    static constexpr int kMaxSortKeys = 4;
+    static constexpr int kDefaultResetThreshold = 256;
+
+    explicit SortedOrderModel(QObject* parent = nullptr);
+    ~SortedOrderModel() override;
+
+    OrdersService* service() const { return m_service; }
+    void setService(OrdersService* service);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QStringList sortKeys() const { return m_sortKeyNames; }
+    void setSortKeys(const QStringList& keys);
+
+    QString filterStatus() const { return m_filterStatus; }
+    void setFilterStatus(const QString& status);
+
+    QString searchText() const { return m_searchText; }
+    void setSearchText(const QString& text);
+
+    int resetThreshold() const { return m_resetThreshold; }
+    void setResetThreshold(int threshold);
+
+    Q_INVOKABLE void refresh();
+    Q_INVOKABLE QVariantMap get(int index) const;
+
+signals:
+    void countChanged();
+    void sortKeysChanged();
+    void filterStatusChanged();
+    void searchTextChanged();
+    void resetThresholdChanged();
+    void serviceChanged();
+
+private slots:
+    void onOrderChanges(const orders::OrderChangeSet& changes);
+
+private:
+    using Handle = OrderStore::Handle;
+    using Keys = std::array<qint64, kMaxSortKeys>;
+
+    struct SortKey {
+        OrderQuery::SortKey field;
+        bool descending;
+    };
+
+    void rebuild();
+    bool matchesFilter(Handle handle) const;
+    Keys keysOf(Handle handle) const;
+    bool less(Handle a, Handle b) const;
+    int compareKey(int i, qint64 a, qint64 b) const;
+
+    int rowOf(Handle handle) const;
+    int insertionRow(Handle handle) const;
+    void insertRow(Handle handle);
+    void removeRow(int row);
+    void repositionRow(int row, Handle handle, const QList<int>& roles);
+
+    OrdersService* m_service = nullptr;
+    QStringList m_sortKeyNames;
+    std::vector<SortKey> m_sortKeys;
+    QString m_filterStatus;
+    QString m_searchText;
+    int m_resetThreshold = kDefaultResetThreshold;
+
+    std::vector<Handle> m_rows;        // row -> handle, in sort order
+    std::vector<Keys> m_keys;          // handle -> sort-key snapshot (valid while m_member)
+    std::vector<quint8> m_member;      // handle -> is the order in the view
+};
+
+} // namespace orders
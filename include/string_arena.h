@@ -0,0 +1,70 @@
+/**
+ * =============================================================================
+ * String Arena - 字符串块分配器
+ * =============================================================================
+ *
+ * 把大量短字符串（订单 ID、驻留池中的名称）连续存放在少量大块内存中，
+ * 代替每个字符串一次堆分配：
+ * - store()：把字符拷贝到当前块末尾，返回指向块内的 QStringView
+ * - reset()：O(1)，只把游标移回起点，已分配的块留给下一轮复用
+ * - release()：真正释放所有块
+ *
+ * 返回的 QStringView 在 reset()/release() 之前一直有效（块不会移动）。
+ * 视图只在存储内部使用；交给外部（QML、信号参数）时应拷贝为 QString。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QStringView>
+#include <memory>
+#include <vector>
+
+namespace orders {
+
+class StringArena
+{
+public:
+    static constexpr qsizetype kDefaultChunkChars = 64 * 1024;  // 每块 128 KB
+
+    explicit StringArena(qsizetype chunkChars = kDefaultChunkChars);
+
+    StringArena(StringArena&&) noexcept = default;
+    StringArena& operator=(StringArena&&) noexcept = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    /**
+     * @brief 拷贝字符串到块中
+     * @return 指向块内副本的视图
+     */
+    QStringView store(QStringView str);
+
+    /**
+     * @brief 清空内容但保留已分配的块（O(1)），之前返回的视图全部失效
+     */
+    void reset();
+
+    /**
+     * @brief 释放所有块，之前返回的视图全部失效
+     */
+    void release();
+
+    /**
+     * @brief 已分配的字节数（包括未使用的部分）
+     */
+    qsizetype bytesReserved() const;
+
+private:
+    struct Chunk {
+        std::unique_ptr<char16_t[]> data;
+        qsizetype capacity = 0;
+    };
+
+    qsizetype m_chunkChars;
+    std::vector<Chunk> m_chunks;
+    std::size_t m_current = 0;   // 当前写入的块
+    qsizetype m_used = 0;        // 当前块已用字符数
+};
+
+} // namespace orders
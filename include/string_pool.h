@@ -0,0 +1,63 @@
+/**
+ * =============================================================================
+ * String Pool - 字符串驻留池
+ * =============================================================================
+ *
+ * 将重复出现的字符串（客户名、产品名、状态）映射为 32 位 ID，
+ * 每个不同的字符串只保存一份。OrderStore 的字符串列只存 ID。
+ *
+ * 字符内容存放在 StringArena 中，驻留新字符串不会单独分配堆内存；
+ * clear() 为 O(1) 的块复用，而不是逐个释放字符串。
+ *
+ * ID 按首次出现顺序分配，在 clear() 之前保持不变。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include "string_arena.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringView>
+#include <limits>
+#include <vector>
+
+namespace orders {
+
+class StringPool
+{
+public:
+    using Id = quint32;
+    static constexpr Id InvalidId = std::numeric_limits<Id>::max();
+
+    /**
+     * @brief 驻留字符串，已存在时返回已有 ID
+     */
+    Id intern(QStringView str);
+
+    /**
+     * @brief 查找字符串 ID，不存在时返回 InvalidId（不会插入）
+     */
+    Id find(QStringView str) const { return m_ids.value(str, InvalidId); }
+
+    /**
+     * @brief 按 ID 取字符串视图（零拷贝，clear() 之前有效）
+     */
+    QStringView view(Id id) const { return m_strings[id]; }
+
+    /**
+     * @brief 按 ID 取字符串副本（用于交给 QML 等外部使用者）
+     */
+    QString at(Id id) const { return m_strings[id].toString(); }
+
+    int size() const { return static_cast<int>(m_strings.size()); }
+    void clear();
+
+private:
+    StringArena m_arena;                  // 字符内容
+    std::vector<QStringView> m_strings;   // ID -> 字符串（指向 m_arena）
+    QHash<QStringView, Id> m_ids;         // 字符串 -> ID
+};
+
+} // namespace orders
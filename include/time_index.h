@@ -0,0 +1,85 @@
+/**
+ * =============================================================================
+ * Time Index - 时间有序索引
+ * =============================================================================
+ *
+ * 维护 (时间戳, Handle) 的有序集合，支持 O(log n + k) 的时间范围查询。
+ * OrderStore 为 createdAt 与 updatedAt 各维护一个。
+ *
+ * 【结构】
+ * - 有序主段（run）：按 (时间, Handle) 排序的数组，二分查找定位范围
+ * - 追加缓冲（buffer）：乱序到达的条目先放在这里，超过阈值后排序并合并进主段
+ *   新订单的时间戳几乎总是递增的，绝大多数插入直接追加到主段末尾
+ * - 删除：主段中的条目只打删除标记（二分定位），缓冲中的条目直接移除；
+ *   删除标记在下一次合并时清理
+ *
+ * 查询代价：主段二分 O(log n) + 命中 k 条 + 扫描缓冲 O(B)，B 有上限。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+
+namespace orders {
+
+class TimeIndex
+{
+public:
+    using Handle = quint32;
+
+    /**
+     * @brief 插入一个条目
+     */
+    void insert(qint64 timeMs, Handle handle);
+
+    /**
+     * @brief 删除一个条目（时间戳必须与插入时一致）
+     */
+    void remove(qint64 timeMs, Handle handle);
+
+    void clear();
+
+    /**
+     * @brief 存储压缩后按映射表更新 Handle
+     *
+     * remap 是单调的，条目间的相对顺序不变，无需重新排序
+     */
+    void remap(const QVector<Handle>& remap);
+
+    /**
+     * @brief 查询时间落在 [fromMs, toMs) 内的 Handle，按时间升序
+     */
+    std::vector<Handle> range(qint64 fromMs, qint64 toMs) const;
+
+    int size() const { return static_cast<int>(m_run.size() + m_buffer.size()) - m_removed; }
+
+private:
+    struct Entry {
+        qint64 timeMs;
+        Handle handle;
+        quint32 removed;  // 删除标记（仅主段使用）
+
+        bool operator<(const Entry& other) const
+        {
+            return timeMs < other.timeMs || (timeMs == other.timeMs && handle < other.handle);
+        }
+    };
+
+    static constexpr std::size_t kMinBufferLimit = 256;
+
+    /**
+     * @brief 将缓冲排序并合并进主段，同时清理删除标记
+     */
+    void merge();
+
+    std::size_t bufferLimit() const;
+
+    std::vector<Entry> m_run;       // 有序主段
+    std::vector<Entry> m_buffer;    // 乱序追加缓冲（无序）
+    int m_removed = 0;              // 主段中带删除标记的条目数
+};
+
+} // namespace orders
@@ -0,0 +1,54 @@
+/**
+ * =============================================================================
+ * Trigram Index - 三元组倒排索引
+ * =============================================================================
+ *
+ * 子串搜索用的倒排索引：把字符串（忽略大小写）拆成连续的 3 字符片段（trigram），
+ * 每个 trigram 对应包含它的字符串 ID 有序列表。查询时取查询串所有 trigram
+ * 的列表求交集，得到候选字符串，再做一次精确的子串校验。
+ *
+ * 索引的对象是 StringPool 中的驻留字符串而不是订单行：
+ * 同一个客户名/产品名无论出现在多少订单中都只索引一次。
+ * 驻留池只增不减（直到 clear），因此索引也只需支持追加。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringView>
+#include <vector>
+
+namespace orders {
+
+class TrigramIndex
+{
+public:
+    using Id = quint32;
+    static constexpr int kGramSize = 3;
+
+    /**
+     * @brief 索引字符串（同一 ID 只索引一次）
+     */
+    void add(Id id, QStringView text);
+
+    bool contains(Id id) const { return id < m_indexed.size() && m_indexed[id]; }
+
+    /**
+     * @brief 包含查询串全部 trigram 的字符串 ID（升序，未做子串校验）
+     *
+     * 查询串长度需不少于 kGramSize
+     */
+    std::vector<Id> candidates(QStringView query) const;
+
+    void clear();
+
+private:
+    static quint64 gramKey(const QChar* s);
+
+    QHash<quint64, std::vector<Id>> m_postings;  // trigram -> 有序字符串 ID 列表
+    std::vector<quint8> m_indexed;               // 字符串 ID 是否已索引
+};
+
+} // namespace orders
@@ -64,12 +64,13 @@ Page {
 
     // -------------------------------------------------------------------------
     // 【数据模型使用】
-    // OrderModel 是在 C++ 中定义的 QAbstractListModel 子类
+    // SortedOrderModel 是在 C++ 中定义的 QAbstractListModel 子类
+    // （与 OrderModel 角色相同，额外支持多键排序）
     // 通过 qmlRegisterType 注册到 QML
     // service 属性绑定到 OrdersService 单例，模型会自动监听数据变化
     // 【修改点2】改为你的模型类名和服务名
     // -------------------------------------------------------------------------
-    OrderModel {
+    SortedOrderModel {
         id: orderModel
         service: OrdersService
     }
@@ -96,6 +97,18 @@ Page {
 
             Item { Layout.fillWidth: true }
 
+            // -----------------------------------------------------------------
+            // 【搜索框】
+            // 按客户名/产品名子串搜索，由 C++ 侧的 trigram 索引完成，
+            // 不需要在 JS 中遍历 getAllOrders()
+            // -----------------------------------------------------------------
+            TextField {
+                id: searchField
+                Layout.preferredWidth: 200
+                placeholderText: qsTr("Search customer / product")
+                onTextChanged: orderModel.searchText = text
+            }
+
             // -----------------------------------------------------------------
             // 【筛选器】
             // ComboBox 用于状态筛选
@@ -109,6 +122,25 @@ Page {
                 }
             }
 
+            // -----------------------------------------------------------------
+            // 【排序】
+            // sortKeys 为排序键列表，前缀 "-" 表示降序；
+            // 排序在 C++ 中增量维护，数据变化时只移动受影响的行
+            // -----------------------------------------------------------------
+            ComboBox {
+                id: sortSelector
+                textRole: "text"
+                valueRole: "keys"
+                model: [
+                    { text: qsTr("Created"), keys: [] },
+                    { text: qsTr("Newest"), keys: ["-createdAt"] },
+                    { text: qsTr("Status"), keys: ["status", "-createdAt"] },
+                    { text: qsTr("Total"), keys: ["-total"] },
+                    { text: qsTr("Customer"), keys: ["customerName", "-createdAt"] }
+                ]
+                onCurrentValueChanged: orderModel.sortKeys = currentValue
+            }
+
             // -----------------------------------------------------------------
             // 【MPF 按钮组件】
             // MPFButton 是 MPF UI 组件库提供的统一风格按钮
@@ -134,18 +166,18 @@ Page {
         spacing: Theme ? Theme.spacingMedium : 16
 
         // ---------------------------------------------------------------------
-        // 【服务方法调用】
-        // 直接调用 OrdersService 的 Q_INVOKABLE 方法获取数据
+        // 【服务属性绑定】
+        // 绑定 OrdersService 的统计属性，数据变化时随 statsChanged 自动刷新
         // ---------------------------------------------------------------------
         StatCard {
             label: qsTr("Total Orders")
-            value: OrdersService.getOrderCount()
+            value: OrdersService.orderCount
             Layout.fillWidth: true
         }
 
         StatCard {
             label: qsTr("Revenue")
-            value: "$" + OrdersService.getTotalRevenue().toFixed(2)
+            value: "$" + OrdersService.totalRevenue.toFixed(2)
             Layout.fillWidth: true
         }
     }
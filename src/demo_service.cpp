@@ -1,4 +1,5 @@
 #include "demo_service.h"
+#include "response_cache.h"
 #include <mpf/http/http_client.h>
 #include <mpf/logger.h>
 
@@ -22,13 +23,40 @@ DemoService::~DemoService() = default;
 // HTTP Demo
 // =============================================================================
 
+void DemoService::setResponseCache(std::shared_ptr<ResponseCache> cache)
+{
+    m_responseCache = std::move(cache);
+}
+
 void DemoService::testGet(const QString& url)
 {
     MPF_LOG_INFO("DemoService", QString("GET %1").arg(url).toStdString().c_str());
 
     m_requestTimer.start();
 
-    auto* reply = m_httpClient->get(QUrl(url));
+    const QUrl requestUrl(url);
+    if (m_responseCache) {
+        const QByteArray key = ResponseCache::key(requestUrl);
+        const ResponseCache::Entry cached = m_responseCache->lookup(key);
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+
+        if (cached.isFresh(now)) {
+            emit httpResponseReceived(true, cached.status, QString::fromUtf8(cached.body),
+                                      static_cast<int>(m_requestTimer.elapsed()));
+            return;
+        }
+        if (cached.canServeStale(now)) {
+            // Show the stale copy right away; the background request only updates the cache
+            emit httpResponseReceived(true, cached.status, QString::fromUtf8(cached.body),
+                                      static_cast<int>(m_requestTimer.elapsed()));
+            revalidate(requestUrl, key, false);
+            return;
+        }
+        revalidate(requestUrl, key, true);
+        return;
+    }
+
+    auto* reply = m_httpClient->get(requestUrl);
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         int elapsed = static_cast<int>(m_requestTimer.elapsed());
         int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
@@ -46,6 +74,46 @@ void DemoService::testGet(const QString& url)
     });
 }
 
+void DemoService::revalidate(const QUrl& url, const QByteArray& cacheKey, bool report)
+{
+    const ResponseCache::Entry cached = m_responseCache->lookup(cacheKey);
+
+    mpf::http::HttpClient::RequestOptions options;
+    for (const auto& header : ResponseCache::conditionalHeaders(cached)) {
+        options.headers[header.first] = header.second;
+    }
+
+    auto* reply = m_httpClient->get(url, options);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, cacheKey, report]() {
+        reply->deleteLater();
+        int elapsed = static_cast<int>(m_requestTimer.elapsed());
+        int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+        if (ResponseCache::isNotModified(reply)) {
+            const ResponseCache::Entry entry = m_responseCache->refresh(cacheKey, reply);
+            if (report) {
+                emit httpResponseReceived(entry.isValid(), statusCode, QString::fromUtf8(entry.body), elapsed);
+            }
+            return;
+        }
+
+        bool success = (reply->error() == QNetworkReply::NoError);
+        QString body;
+
+        if (success) {
+            const QByteArray data = reply->readAll();
+            m_responseCache->store(cacheKey, reply, data);
+            body = QString::fromUtf8(data);
+        } else {
+            body = QString("Error: %1\n%2").arg(reply->errorString(), QString::fromUtf8(reply->readAll()));
+        }
+
+        if (report) {
+            emit httpResponseReceived(success, statusCode, body, elapsed);
+        }
+    });
+}
+
 void DemoService::testPost(const QString& url, const QString& jsonBody)
 {
     MPF_LOG_INFO("DemoService", QString("POST %1").arg(url).toStdString().c_str());
@@ -0,0 +1,315 @@
+#include "group_summary_model.h"
+#include "money.h"
+
+namespace orders {
+
+GroupSummaryModel::GroupSummaryModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+GroupSummaryModel::~GroupSummaryModel() = default;
+
+int GroupSummaryModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) return 0;
+    return static_cast<int>(m_groups.size());
+}
+
+QVariant GroupSummaryModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || !m_service || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    const Group& group = m_groups[static_cast<std::size_t>(index.row())];
+    switch (role) {
+    case KeyRole:
+        return m_service->store().strings().at(group.key);
+    case CountRole:
+        return group.count;
+    case SumRole:
+        return money::toMajor(group.sum);
+    case AvgRole:
+        return group.count > 0 ? money::toMajor(group.sum) / group.count : 0.0;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> GroupSummaryModel::roleNames() const
+{
+    return {
+        {KeyRole, "key"},
+        {CountRole, "count"},
+        {SumRole, "sum"},
+        {AvgRole, "avg"}
+    };
+}
+
+void GroupSummaryModel::setService(OrdersService* service)
+{
+    if (m_service == service) {
+        return;
+    }
+
+    if (m_service) {
+        disconnect(m_service, nullptr, this, nullptr);
+    }
+
+    m_service = service;
+
+    if (m_service) {
+        connect(m_service, &OrdersService::orderChanges, this, &GroupSummaryModel::onOrderChanges);
+    }
+
+    rebuild();
+    emit serviceChanged();
+}
+
+void GroupSummaryModel::setGroupBy(const QString& field)
+{
+    static const QHash<QString, GroupField> fields = {
+        {QStringLiteral("status"), GroupField::Status},
+        {QStringLiteral("customerName"), GroupField::CustomerName},
+        {QStringLiteral("productName"), GroupField::ProductName},
+    };
+
+    auto it = fields.constFind(field);
+    if (it == fields.constEnd() || m_groupByName == field) {
+        return;
+    }
+
+    m_groupByName = field;
+    m_groupBy = it.value();
+    rebuild();
+    emit groupByChanged();
+}
+
+void GroupSummaryModel::setResetThreshold(int threshold)
+{
+    if (m_resetThreshold != threshold) {
+        m_resetThreshold = threshold;
+        emit resetThresholdChanged();
+    }
+}
+
+void GroupSummaryModel::refresh()
+{
+    rebuild();
+}
+
+QVariantMap GroupSummaryModel::get(int index) const
+{
+    if (!m_service || index < 0 || index >= rowCount()) {
+        return {};
+    }
+
+    const QModelIndex idx = this->index(index);
+    return {
+        {"key", data(idx, KeyRole)},
+        {"count", data(idx, CountRole)},
+        {"sum", data(idx, SumRole)},
+        {"avg", data(idx, AvgRole)}
+    };
+}
+
+void GroupSummaryModel::onOrderChanges(const OrderChangeSet& changes)
+{
+    if (changes.reset || changes.size() > m_resetThreshold) {
+        rebuild();
+        return;
+    }
+
+    const int oldCount = rowCount();
+    const OrderStore& store = m_service->store();
+
+    // Change handles are pre-compaction, so the snapshots stay indexed by
+    // them until every change is applied; the store is read through the remap
+    const bool compacted = !changes.remap.isEmpty();
+    const std::size_t slots = compacted ? static_cast<std::size_t>(changes.remap.size())
+                                        : static_cast<std::size_t>(store.slotCount());
+    if (m_keyOf.size() < slots) {
+        m_keyOf.resize(slots, StringPool::InvalidId);
+        m_totalOf.resize(slots, 0);
+    }
+
+    const OrderFields relevant = groupFields() | OrderField::Total;
+    QSet<StringPool::Id> changed;
+
+    for (const OrderChange& change : changes.changes) {
+        const Handle handle = change.handle;
+        if (change.kind == OrderChange::Kind::Updated && !(change.fields & relevant)) {
+            continue;
+        }
+
+        const StringPool::Id oldKey = m_keyOf[handle];
+        const qint64 oldTotal = m_totalOf[handle];
+        StringPool::Id newKey = StringPool::InvalidId;
+        qint64 newTotal = 0;
+        if (change.kind != OrderChange::Kind::Removed) {
+            const Handle current = compacted ? changes.remap[handle] : handle;
+            if (current != OrderStore::InvalidHandle && store.isAlive(current)) {
+                newKey = groupOf(current);
+                newTotal = store.lineTotalAt(current);
+            }
+        }
+
+        if (oldKey != StringPool::InvalidId && oldKey == newKey) {
+            // Same group: adjust in place so the row neither leaves nor moves
+            m_groups[static_cast<std::size_t>(m_rowOf.value(oldKey))].sum += newTotal - oldTotal;
+            changed.insert(oldKey);
+        } else {
+            if (oldKey != StringPool::InvalidId) {
+                subtract(oldKey, oldTotal, changed);
+            }
+            if (newKey != StringPool::InvalidId) {
+                add(newKey, newTotal, changed);
+            }
+        }
+        m_keyOf[handle] = newKey;
+        m_totalOf[handle] = newTotal;
+    }
+
+    if (compacted) {
+        std::vector<StringPool::Id> keys(store.slotCount(), StringPool::InvalidId);
+        std::vector<qint64> totals(store.slotCount(), 0);
+        const std::size_t n = qMin(m_keyOf.size(), slots);
+        for (std::size_t h = 0; h < n; ++h) {
+            const Handle to = changes.remap[static_cast<qsizetype>(h)];
+            if (to != OrderStore::InvalidHandle && m_keyOf[h] != StringPool::InvalidId) {
+                keys[to] = m_keyOf[h];
+                totals[to] = m_totalOf[h];
+            }
+        }
+        m_keyOf.swap(keys);
+        m_totalOf.swap(totals);
+    }
+
+    QList<int> rows;
+    for (StringPool::Id key : std::as_const(changed)) {
+        auto it = m_rowOf.constFind(key);
+        if (it != m_rowOf.constEnd()) {
+            rows << it.value();
+        }
+    }
+    emitChanged(rows);
+
+    if (rowCount() != oldCount) {
+        emit countChanged();
+    }
+}
+
+void GroupSummaryModel::rebuild()
+{
+    beginResetModel();
+
+    m_groups.clear();
+    m_rowOf.clear();
+    m_keyOf.clear();
+    m_totalOf.clear();
+
+    if (m_service) {
+        const OrderStore& store = m_service->store();
+        m_keyOf.assign(store.slotCount(), StringPool::InvalidId);
+        m_totalOf.assign(store.slotCount(), 0);
+
+        store.forEach([this, &store](Handle h, const OrderView&) {
+            const StringPool::Id key = groupOf(h);
+            const qint64 total = store.lineTotalAt(h);
+            m_keyOf[h] = key;
+            m_totalOf[h] = total;
+
+            auto it = m_rowOf.constFind(key);
+            if (it == m_rowOf.constEnd()) {
+                it = m_rowOf.insert(key, static_cast<int>(m_groups.size()));
+                m_groups.push_back({key});
+            }
+            Group& group = m_groups[static_cast<std::size_t>(it.value())];
+            ++group.count;
+            group.sum += total;
+        });
+    }
+
+    endResetModel();
+    emit countChanged();
+}
+
+StringPool::Id GroupSummaryModel::groupOf(Handle handle) const
+{
+    const OrderStore& store = m_service->store();
+    switch (m_groupBy) {
+    case GroupField::Status: return store.statusIdAt(handle);
+    case GroupField::CustomerName: return store.customerIdAt(handle);
+    case GroupField::ProductName: return store.productIdAt(handle);
+    }
+    return StringPool::InvalidId;
+}
+
+OrderFields GroupSummaryModel::groupFields() const
+{
+    switch (m_groupBy) {
+    case GroupField::Status: return OrderField::Status;
+    case GroupField::CustomerName: return OrderField::CustomerName;
+    case GroupField::ProductName: return OrderField::ProductName;
+    }
+    return {};
+}
+
+void GroupSummaryModel::add(StringPool::Id key, qint64 total, QSet<StringPool::Id>& changed)
+{
+    auto it = m_rowOf.constFind(key);
+    if (it == m_rowOf.constEnd()) {
+        const int row = rowCount();
+        beginInsertRows(QModelIndex(), row, row);
+        m_groups.push_back({key, 1, total});
+        m_rowOf.insert(key, row);
+        endInsertRows();
+        return;
+    }
+
+    Group& group = m_groups[static_cast<std::size_t>(it.value())];
+    ++group.count;
+    group.sum += total;
+    changed.insert(key);
+}
+
+void GroupSummaryModel::subtract(StringPool::Id key, qint64 total, QSet<StringPool::Id>& changed)
+{
+    auto it = m_rowOf.constFind(key);
+    if (it == m_rowOf.constEnd()) {
+        return;
+    }
+
+    const int row = it.value();
+    Group& group = m_groups[static_cast<std::size_t>(row)];
+    --group.count;
+    group.sum -= total;
+
+    if (group.count > 0) {
+        changed.insert(key);
+        return;
+    }
+
+    // Last order of the group: drop the row. Groups are few (statuses,
+    // customers, products), so re-indexing the rows below is cheap.
+    beginRemoveRows(QModelIndex(), row, row);
+    m_groups.erase(m_groups.begin() + row);
+    m_rowOf.remove(key);
+    for (int r = row; r < rowCount(); ++r) {
+        m_rowOf[m_groups[static_cast<std::size_t>(r)].key] = r;
+    }
+    endRemoveRows();
+    changed.remove(key);
+}
+
+void GroupSummaryModel::emitChanged(const QList<int>& rows)
+{
+    static const QList<int> roles = {CountRole, SumRole, AvgRole};
+    for (int row : rows) {
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, roles);
+    }
+}
+
+} // namespace orders
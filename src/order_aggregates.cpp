@@ -0,0 +1,49 @@
+#include "order_aggregates.h"
+
+namespace orders {
+
+void OrderAggregates::add(StringPool::Id status, qint64 revenue)
+{
+    m_total.count += 1;
+    m_total.revenue += revenue;
+
+    Bucket& bucket = m_byStatus[status];
+    bucket.count += 1;
+    bucket.revenue += revenue;
+}
+
+void OrderAggregates::remove(StringPool::Id status, qint64 revenue)
+{
+    m_total.count -= 1;
+    m_total.revenue -= revenue;
+
+    auto it = m_byStatus.find(status);
+    if (it == m_byStatus.end()) {
+        return;
+    }
+    it->count -= 1;
+    it->revenue -= revenue;
+    if (it->count <= 0) {
+        m_byStatus.erase(it);
+    }
+}
+
+void OrderAggregates::clear()
+{
+    m_total = Bucket{};
+    m_byStatus.clear();
+}
+
+QVariantMap OrderAggregates::statusSummary(const StringPool& pool) const
+{
+    QVariantMap result;
+    for (auto it = m_byStatus.constBegin(); it != m_byStatus.constEnd(); ++it) {
+        result.insert(pool.at(it.key()), QVariantMap{
+            {"count", it->count},
+            {"revenue", money::toMajor(it->revenue)}
+        });
+    }
+    return result;
+}
+
+} // namespace orders
@@ -0,0 +1,77 @@
+#include "order_change_set.h"
+
+namespace orders {
+
+OrderFields OrderChange::diff(const Order& before, const Order& after)
+{
+    OrderFields fields;
+    if (before.customerName != after.customerName) fields |= OrderField::CustomerName;
+    if (before.productName != after.productName) fields |= OrderField::ProductName;
+    if (before.quantity != after.quantity) fields |= OrderField::Quantity;
+    if (before.priceMinor != after.priceMinor) fields |= OrderField::Price;
+    if (before.status != after.status) fields |= OrderField::Status;
+    if (before.createdAt != after.createdAt) fields |= OrderField::CreatedAt;
+    if (before.updatedAt != after.updatedAt) fields |= OrderField::UpdatedAt;
+    if (before.totalMinor() != after.totalMinor()) fields |= OrderField::Total;
+    return fields;
+}
+
+void OrderChangeBuilder::inserted(OrderStore::Handle handle, const QString& id)
+{
+    m_positions.insert(handle, m_set.changes.size());
+    m_set.changes.append({OrderChange::Kind::Inserted, handle, id, {}});
+}
+
+void OrderChangeBuilder::updated(OrderStore::Handle handle, const QString& id, OrderFields fields)
+{
+    auto it = m_positions.constFind(handle);
+    if (it == m_positions.constEnd()) {
+        m_positions.insert(handle, m_set.changes.size());
+        m_set.changes.append({OrderChange::Kind::Updated, handle, id, fields});
+        return;
+    }
+
+    OrderChange& change = m_set.changes[it.value()];
+    if (change.kind == OrderChange::Kind::Updated) {
+        change.fields |= fields;
+    }
+    // 新插入的订单：监听方会整行读取，无需记录字段
+}
+
+void OrderChangeBuilder::removed(OrderStore::Handle handle, const QString& id)
+{
+    auto it = m_positions.find(handle);
+    if (it == m_positions.end()) {
+        m_positions.insert(handle, m_set.changes.size());
+        m_set.changes.append({OrderChange::Kind::Removed, handle, id, {}});
+        return;
+    }
+
+    OrderChange& change = m_set.changes[it.value()];
+    if (change.kind == OrderChange::Kind::Inserted) {
+        // 本批次内插入又删除：对监听方来说什么都没发生
+        change.handle = OrderStore::InvalidHandle;
+        ++m_dropped;
+        m_positions.erase(it);
+    } else {
+        change.kind = OrderChange::Kind::Removed;
+        change.fields = {};
+    }
+}
+
+OrderChangeSet OrderChangeBuilder::take()
+{
+    if (m_dropped > 0) {
+        m_set.changes.removeIf([](const OrderChange& change) {
+            return change.handle == OrderStore::InvalidHandle;
+        });
+    }
+
+    OrderChangeSet set = std::move(m_set);
+    m_set = OrderChangeSet();
+    m_positions.clear();
+    m_dropped = 0;
+    return set;
+}
+
+} // namespace orders
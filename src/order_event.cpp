@@ -0,0 +1,59 @@
+#include "order_event.h"
+
+namespace orders {
+
+QString OrderEvent::typeName() const
+{
+    switch (type) {
+    case Type::Created: return QStringLiteral("created");
+    case Type::Updated: return QStringLiteral("updated");
+    case Type::Deleted: return QStringLiteral("deleted");
+    }
+    return QString();
+}
+
+QStringList OrderEvent::changedFields() const
+{
+    return type == Type::Deleted ? before.keys() : after.keys();
+}
+
+OrderEvent OrderEvent::created(qint64 sequence, const Order& order)
+{
+    OrderEvent event;
+    event.sequence = sequence;
+    event.type = Type::Created;
+    event.id = order.id;
+    event.after = order.toVariantMap();
+    return event;
+}
+
+OrderEvent OrderEvent::deleted(qint64 sequence, const Order& order)
+{
+    OrderEvent event;
+    event.sequence = sequence;
+    event.type = Type::Deleted;
+    event.id = order.id;
+    event.before = order.toVariantMap();
+    return event;
+}
+
+OrderEvent OrderEvent::updated(qint64 sequence, const Order& before, const Order& after)
+{
+    OrderEvent event;
+    event.sequence = sequence;
+    event.type = Type::Updated;
+    event.id = after.id;
+
+    const QVariantMap oldValues = before.toVariantMap();
+    const QVariantMap newValues = after.toVariantMap();
+    for (auto it = newValues.constBegin(); it != newValues.constEnd(); ++it) {
+        const QVariant oldValue = oldValues.value(it.key());
+        if (oldValue != it.value()) {
+            event.before.insert(it.key(), oldValue);
+            event.after.insert(it.key(), it.value());
+        }
+    }
+    return event;
+}
+
+} // namespace orders
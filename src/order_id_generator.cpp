@@ -0,0 +1,93 @@
+#include "order_id_generator.h"
+
+#include <QDateTime>
+
+namespace orders {
+
+namespace {
+
+// Crockford Base32 字母表，ASCII 顺序递增，定长编码的字典序即数值顺序
+constexpr char kAlphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+constexpr quint64 kSequenceMask = (quint64(1) << SnowflakeIdGenerator::kSequenceBits) - 1;
+constexpr int kTimestampShift = SnowflakeIdGenerator::kNodeBits + SnowflakeIdGenerator::kSequenceBits;
+
+int decodeChar(QChar c)
+{
+    const char16_t u = c.toUpper().unicode();
+    if (u >= '0' && u <= '9') return u - '0';
+    // Crockford 容错：O -> 0，I/L -> 1
+    if (u == 'O') return 0;
+    if (u == 'I' || u == 'L') return 1;
+    for (int i = 10; i < 32; ++i) {
+        if (kAlphabet[i] == u) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+SnowflakeIdGenerator::SnowflakeIdGenerator(quint32 nodeId)
+    : m_nodeId(nodeId & kMaxNodeId)
+{
+}
+
+quint64 SnowflakeIdGenerator::nextRaw()
+{
+    const quint64 now = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() - kEpochMs);
+
+    quint64 prev = m_state.load(std::memory_order_relaxed);
+    quint64 next;
+    do {
+        if (now > (prev >> kSequenceBits)) {
+            next = now << kSequenceBits;  // 新的毫秒，序列号归零
+        } else {
+            next = prev + 1;              // 同一毫秒或时钟回拨：序列号递增，溢出则进位
+        }
+    } while (!m_state.compare_exchange_weak(prev, next, std::memory_order_relaxed));
+
+    const quint64 timestamp = next >> kSequenceBits;
+    const quint64 sequence = next & kSequenceMask;
+    return (timestamp << kTimestampShift)
+         | (quint64(m_nodeId) << kSequenceBits)
+         | sequence;
+}
+
+QString SnowflakeIdGenerator::encode(quint64 id)
+{
+    QString text(kEncodedLength, Qt::Uninitialized);
+    QChar* out = text.data();
+    for (int i = kEncodedLength - 1; i >= 0; --i) {
+        out[i] = QLatin1Char(kAlphabet[id & 0x1F]);
+        id >>= 5;
+    }
+    return text;
+}
+
+quint64 SnowflakeIdGenerator::decode(QStringView text, bool* ok)
+{
+    if (ok) *ok = false;
+    if (text.size() != kEncodedLength) {
+        return 0;
+    }
+
+    quint64 id = 0;
+    for (int i = 0; i < kEncodedLength; ++i) {
+        const int v = decodeChar(text[i]);
+        // 13 × 5 = 65 位：首字符对应第 60~64 位，其中第 64 位不存在、
+        // 第 63 位保留为 0，因此首字符只能是 0~7
+        if (v < 0 || (i == 0 && v > 7)) {
+            return 0;
+        }
+        id = (id << 5) | quint64(v);
+    }
+    if (ok) *ok = true;
+    return id;
+}
+
+qint64 SnowflakeIdGenerator::timestampMs(quint64 id)
+{
+    return static_cast<qint64>(id >> kTimestampShift) + kEpochMs;
+}
+
+} // namespace orders
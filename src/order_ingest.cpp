@@ -0,0 +1,492 @@
+#include "order_ingest.h"
+#include "order_wire.h"
+
+#include <QCborStreamReader>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimeZone>
+
+#include <limits>
+
+namespace orders {
+
+namespace {
+
+bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// 数字与 true/false/null 中可能出现的字符，具体是否合法由 QJsonDocument 校验
+bool isScalarChar(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E';
+}
+
+// 值类型不符（如 null）时跳过，字段保持默认值
+
+bool readText(QCborStreamReader& reader, QString& out)
+{
+    if (!reader.isString()) {
+        return reader.next();
+    }
+    out.clear();
+    auto chunk = reader.readString();
+    while (chunk.status == QCborStreamReader::Ok) {
+        out += chunk.data;
+        chunk = reader.readString();
+    }
+    return chunk.status == QCborStreamReader::EndOfString;
+}
+
+bool readInteger(QCborStreamReader& reader, qint64& out)
+{
+    if (reader.isInteger()) {
+        out = reader.toInteger();
+    }
+    return reader.next();
+}
+
+bool readTime(QCborStreamReader& reader, QDateTime& out)
+{
+    if (reader.isInteger()) {
+        out = QDateTime::fromMSecsSinceEpoch(reader.toInteger(), QTimeZone::UTC);
+    }
+    return reader.next();
+}
+
+/**
+ * @brief 读取一个数组元素：map 解码为订单追加到 out，其他类型跳过
+ * @return 失败时 reader.lastError() 为 EndOfFile 表示元素尚不完整
+ */
+bool readElement(QCborStreamReader& reader, QList<Order>& out)
+{
+    if (!reader.isMap()) {
+        return reader.next();
+    }
+    if (!reader.enterContainer()) {
+        return false;
+    }
+
+    Order order;
+    order.status = QStringLiteral("pending");
+    bool ok = true;
+    while (ok && reader.hasNext()) {
+        if (!reader.isUnsignedInteger()) {
+            ok = reader.next() && reader.next();  // 非整数键：连同值一起跳过
+            continue;
+        }
+        const quint64 key = reader.toUnsignedInteger();
+        if (!reader.next()) {
+            return false;
+        }
+
+        qint64 n = 0;
+        switch (static_cast<wire::Key>(key)) {
+        case wire::Key::Id:           ok = readText(reader, order.id); break;
+        case wire::Key::CustomerName: ok = readText(reader, order.customerName); break;
+        case wire::Key::ProductName:  ok = readText(reader, order.productName); break;
+        case wire::Key::Status:       ok = readText(reader, order.status); break;
+        case wire::Key::Quantity:
+            ok = readInteger(reader, n);
+            order.quantity = static_cast<int>(n);
+            break;
+        case wire::Key::PriceMinor:   ok = readInteger(reader, order.priceMinor); break;
+        case wire::Key::CreatedAt:    ok = readTime(reader, order.createdAt); break;
+        case wire::Key::UpdatedAt:    ok = readTime(reader, order.updatedAt); break;
+        default:                      ok = reader.next(); break;
+        }
+    }
+    if (!ok || reader.lastError() != QCborError::NoError || !reader.leaveContainer()) {
+        return false;
+    }
+
+    out.append(order);
+    return true;
+}
+
+} // namespace
+
+// =============================================================================
+// OrderJsonStream
+// =============================================================================
+
+bool OrderJsonStream::feed(const QByteArray& chunk, QList<Order>& out)
+{
+    if (hasError()) {
+        return false;
+    }
+
+    m_buffer.append(chunk);
+
+    // 逐字节扫描即可：JSON 的结构字符都是 ASCII，
+    // 而 UTF-8 多字节字符的每个字节都 >= 0x80，不会被误认
+    const char* data = m_buffer.constData();
+    const qsizetype size = m_buffer.size();
+    for (; m_scan < size; ++m_scan) {
+        const char c = data[m_scan];
+
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+                if (m_depth == 1 && !completeElement(data, m_scan + 1, out)) {
+                    return false;  // 顶层的字符串元素
+                }
+            }
+            continue;
+        }
+
+        if (m_scalar) {
+            if (isScalarChar(c)) {
+                continue;
+            }
+            // 数字/字面量到此结束，当前字符按元素之后的位置处理
+            m_scalar = false;
+            if (!completeElement(data, m_scan, out)) {
+                return false;
+            }
+        }
+
+        if (m_depth >= 2) {
+            // 元素内部：只跟踪嵌套，内容在元素结束时整体校验
+            switch (c) {
+            case '"':
+                m_inString = true;
+                break;
+            case '{':
+            case '[':
+                ++m_depth;
+                break;
+            case '}':
+            case ']':
+                if (--m_depth == 1 && !completeElement(data, m_scan + 1, out)) {
+                    return false;
+                }
+                break;
+            default:
+                break;
+            }
+            continue;
+        }
+
+        if (isJsonSpace(c)) {
+            continue;
+        }
+
+        switch (m_expect) {
+        case Expect::ArrayStart:
+            if (c != '[') {
+                return fail(QStringLiteral("Invalid JSON response: expected an array"));
+            }
+            m_depth = 1;
+            m_expect = Expect::FirstValue;
+            break;
+        case Expect::FirstValue:
+            if (c == ']') {
+                m_depth = 0;
+                m_expect = Expect::End;  // 空数组
+                break;
+            }
+            Q_FALLTHROUGH();
+        case Expect::Value:
+            m_element = m_scan;
+            if (c == '{' || c == '[') {
+                m_depth = 2;
+            } else if (c == '"') {
+                m_inString = true;
+            } else if (isScalarChar(c)) {
+                m_scalar = true;
+            } else {
+                return fail(QStringLiteral("Invalid JSON response: expected an array element"));
+            }
+            break;
+        case Expect::CommaOrEnd:
+            if (c == ',') {
+                m_expect = Expect::Value;
+            } else if (c == ']') {
+                m_depth = 0;
+                m_expect = Expect::End;
+            } else {
+                return fail(QStringLiteral("Invalid JSON response: expected ',' or ']' after an array element"));
+            }
+            break;
+        case Expect::End:
+            return fail(QStringLiteral("Unexpected data after JSON array"));
+        }
+    }
+
+    // 丢弃已消费的字节，只保留未结束的元素
+    if (m_element >= 0) {
+        m_buffer.remove(0, m_element);
+        m_scan -= m_element;
+        m_element = 0;
+    } else {
+        m_buffer.clear();
+        m_scan = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief 一个顶层元素在 end 处结束：校验其 JSON，对象转换为订单，其他类型跳过
+ */
+bool OrderJsonStream::completeElement(const char* data, qsizetype end, QList<Order>& out)
+{
+    const QByteArray raw = QByteArray::fromRawData(data + m_element, end - m_element);
+    const bool container = raw.startsWith('{') || raw.startsWith('[');
+
+    QJsonParseError error;
+    // 字符串、数字与字面量包进数组再校验
+    const QJsonDocument doc = QJsonDocument::fromJson(container ? raw : QByteArray('[' + raw + ']'), &error);
+    if (error.error != QJsonParseError::NoError) {
+        return fail(error.errorString());
+    }
+    if (doc.isObject()) {
+        out.append(Order::fromJson(doc.object()));
+    }
+    m_element = -1;
+    m_expect = Expect::CommaOrEnd;
+    return true;
+}
+
+bool OrderJsonStream::finish()
+{
+    if (hasError()) {
+        return false;
+    }
+    if (m_expect == Expect::ArrayStart) {
+        return fail(QStringLiteral("Invalid JSON response: expected an array"));
+    }
+    if (m_element >= 0) {
+        return fail(QStringLiteral("Invalid JSON response: truncated array element"));
+    }
+    if (m_expect != Expect::End) {
+        return fail(QStringLiteral("Invalid JSON response: truncated array"));
+    }
+    return true;
+}
+
+void OrderJsonStream::reset()
+{
+    *this = OrderJsonStream();
+}
+
+bool OrderJsonStream::fail(const QString& error)
+{
+    m_error = error;
+    m_buffer.clear();
+    m_scan = 0;
+    m_element = -1;
+    return false;
+}
+
+// =============================================================================
+// OrderCborStream
+// =============================================================================
+
+bool OrderCborStream::feed(const QByteArray& chunk, QList<Order>& out)
+{
+    if (hasError()) {
+        return false;
+    }
+    if (m_done) {
+        return chunk.isEmpty() || fail(QStringLiteral("Unexpected data after CBOR array"));
+    }
+
+    m_buffer.append(chunk);
+    if (!m_started && !readHeader()) {
+        return false;
+    }
+    if (!m_started) {
+        return true;  // 数组头还不完整
+    }
+
+    // 每次 feed 从缓冲区起点逐个读取完整的元素（作为顶层的 CBOR 序列），
+    // 不完整的最后一个元素留到下一段字节到达后重新读取
+    QCborStreamReader reader(m_buffer.constData(), m_buffer.size());
+    qsizetype consumed = 0;
+    for (;;) {
+        consumed = reader.currentOffset();
+        if (m_remaining == 0) {
+            m_done = true;
+            break;
+        }
+        if (consumed >= m_buffer.size()) {
+            break;
+        }
+        if (m_remaining < 0 && static_cast<uchar>(m_buffer.at(consumed)) == 0xff) {
+            m_done = true;  // 不定长数组的结束标记
+            ++consumed;
+            break;
+        }
+        if (!readElement(reader, out)) {
+            if (reader.lastError() == QCborError::EndOfFile) {
+                break;
+            }
+            return fail(QStringLiteral("Invalid CBOR response: %1").arg(reader.lastError().toString()));
+        }
+        if (m_remaining > 0) {
+            --m_remaining;
+        }
+    }
+
+    if (m_done && consumed < m_buffer.size()) {
+        return fail(QStringLiteral("Unexpected data after CBOR array"));
+    }
+    m_buffer.remove(0, consumed);
+    return true;
+}
+
+bool OrderCborStream::finish()
+{
+    if (hasError()) {
+        return false;
+    }
+    if (!m_done) {
+        return fail(QStringLiteral("Invalid CBOR response: truncated array"));
+    }
+    return true;
+}
+
+void OrderCborStream::reset()
+{
+    *this = OrderCborStream();
+}
+
+bool OrderCborStream::readHeader()
+{
+    const auto* data = reinterpret_cast<const uchar*>(m_buffer.constData());
+    qsizetype size = m_buffer.size();
+    qsizetype pos = 0;
+
+    // 可选的自描述标签 55799（d9 d9 f7）
+    if (size >= 1 && data[0] == 0xd9) {
+        if (size < 3) {
+            return true;
+        }
+        if (data[1] != 0xd9 || data[2] != 0xf7) {
+            return fail(QStringLiteral("Invalid CBOR response: expected an array"));
+        }
+        pos = 3;
+    }
+    if (size <= pos) {
+        return true;
+    }
+
+    const uchar initial = data[pos++];
+    if ((initial >> 5) != 4) {
+        return fail(QStringLiteral("Invalid CBOR response: expected an array"));
+    }
+
+    const uchar info = initial & 0x1f;
+    if (info == 31) {
+        m_remaining = -1;
+    } else if (info < 24) {
+        m_remaining = info;
+    } else if (info <= 27) {
+        const qsizetype bytes = qsizetype(1) << (info - 24);
+        if (size < pos + bytes) {
+            return true;
+        }
+        quint64 length = 0;
+        for (qsizetype i = 0; i < bytes; ++i) {
+            length = (length << 8) | data[pos + i];
+        }
+        if (length > quint64(std::numeric_limits<qint64>::max())) {
+            return fail(QStringLiteral("Invalid CBOR response: array too long"));
+        }
+        m_remaining = static_cast<qint64>(length);
+        pos += bytes;
+    } else {
+        return fail(QStringLiteral("Invalid CBOR response: expected an array"));
+    }
+
+    m_buffer.remove(0, pos);
+    m_started = true;
+    return true;
+}
+
+bool OrderCborStream::fail(const QString& error)
+{
+    m_error = error;
+    m_buffer.clear();
+    return false;
+}
+
+// =============================================================================
+// OrderIngestWorker
+// =============================================================================
+
+OrderIngestWorker::OrderIngestWorker(int batchSize, QObject* parent)
+    : QObject(parent)
+    , m_batchSize(qMax(1, batchSize))
+{
+}
+
+void OrderIngestWorker::begin(quint64 generation, Format format)
+{
+    m_generation = generation;
+    m_format = format;
+    m_json.reset();
+    m_cbor.reset();
+    m_pending.clear();
+    m_total = 0;
+}
+
+void OrderIngestWorker::feed(quint64 generation, const QByteArray& chunk)
+{
+    if (generation != m_generation || hasError()) {
+        return;
+    }
+
+    const bool ok = m_format == Format::Cbor ? m_cbor.feed(chunk, m_pending)
+                                             : m_json.feed(chunk, m_pending);
+    if (!ok) {
+        m_pending.clear();  // 出错后不再交回任何订单，由 finish() 报告错误
+        return;
+    }
+    flush(false);
+}
+
+void OrderIngestWorker::finish(quint64 generation)
+{
+    if (generation != m_generation) {
+        return;
+    }
+
+    const bool ok = m_format == Format::Cbor ? m_cbor.finish() : m_json.finish();
+    if (ok) {
+        flush(true);
+    }
+    emit finished(generation, ok, errorString(), m_total);
+    begin(0);
+}
+
+void OrderIngestWorker::flush(bool force)
+{
+    qsizetype taken = 0;
+    while (m_pending.size() - taken >= m_batchSize || (force && taken < m_pending.size())) {
+        const qsizetype n = qMin<qsizetype>(m_batchSize, m_pending.size() - taken);
+        const QList<Order> batch = m_pending.mid(taken, n);
+        taken += n;
+        m_total += static_cast<int>(n);
+        emit batchReady(m_generation, batch);
+    }
+    m_pending.remove(0, taken);
+}
+
+bool OrderIngestWorker::hasError() const
+{
+    return m_format == Format::Cbor ? m_cbor.hasError() : m_json.hasError();
+}
+
+QString OrderIngestWorker::errorString() const
+{
+    return m_format == Format::Cbor ? m_cbor.errorString() : m_json.errorString();
+}
+
+} // namespace orders
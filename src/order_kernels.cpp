@@ -0,0 +1,436 @@
+#include "order_kernels.h"
+
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ORDERS_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集；MSVC 的内建函数无需额外开关
+#if defined(__GNUC__) || defined(__clang__)
+#define ORDERS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ORDERS_TARGET(isa)
+#endif
+
+namespace orders::kernels {
+
+namespace {
+
+inline bool matches(std::uint32_t k, std::uint32_t key, bool negate)
+{
+    return (k == key) != negate;
+}
+
+inline void accumulate(MinMax& acc, std::int64_t v)
+{
+    if (acc.count == 0) {
+        acc.min = acc.max = v;
+    } else {
+        if (v < acc.min) acc.min = v;
+        if (v > acc.max) acc.max = v;
+    }
+    ++acc.count;
+}
+
+// =============================================================================
+// 标量实现（同时用于 SIMD 实现的尾部）
+// =============================================================================
+
+std::int64_t sumScalar(const std::int64_t* values, std::size_t n)
+{
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+std::int64_t sumWhereScalar(const std::int64_t* values, const std::uint32_t* keys,
+                            std::uint32_t key, std::size_t n)
+{
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keys[i] == key) {
+            total += values[i];
+        }
+    }
+    return total;
+}
+
+MinMax minMaxScalar(const std::int64_t* values, const std::uint32_t* keys,
+                    std::uint32_t key, std::size_t n, bool negate)
+{
+    MinMax acc;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (matches(keys[i], key, negate)) {
+            accumulate(acc, values[i]);
+        }
+    }
+    return acc;
+}
+
+MinMax minMaxWhereScalar(const std::int64_t* values, const std::uint32_t* keys,
+                         std::uint32_t key, std::size_t n)
+{
+    return minMaxScalar(values, keys, key, n, false);
+}
+
+MinMax minMaxExceptScalar(const std::int64_t* values, const std::uint32_t* keys,
+                          std::uint32_t excluded, std::size_t n)
+{
+    return minMaxScalar(values, keys, excluded, n, true);
+}
+
+#ifdef ORDERS_KERNELS_X86
+
+// 以下常量与辅助函数只在 SIMD 实现中使用
+
+constexpr std::int64_t kInt64Max = std::numeric_limits<std::int64_t>::max();
+constexpr std::int64_t kInt64Min = std::numeric_limits<std::int64_t>::min();
+
+inline int popcount8(unsigned bits)
+{
+    int c = 0;
+    for (; bits; bits &= bits - 1) {
+        ++c;
+    }
+    return c;
+}
+
+/**
+ * @brief 合并 SIMD 主循环与标量尾部的结果
+ */
+MinMax merge(MinMax head, const MinMax& tail)
+{
+    if (tail.count == 0) return head;
+    if (head.count == 0) return tail;
+    if (tail.min < head.min) head.min = tail.min;
+    if (tail.max > head.max) head.max = tail.max;
+    head.count += tail.count;
+    return head;
+}
+
+// =============================================================================
+// SSE4.2 实现：每次处理 4 行
+// =============================================================================
+
+ORDERS_TARGET("sse4.2")
+std::int64_t sumSse(const std::int64_t* values, std::size_t n)
+{
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_epi64(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+        acc1 = _mm_add_epi64(acc1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 2)));
+    }
+    alignas(16) std::int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + sumScalar(values + i, n - i);
+}
+
+ORDERS_TARGET("sse4.2")
+std::int64_t sumWhereSse(const std::int64_t* values, const std::uint32_t* keys,
+                         std::uint32_t key, std::size_t n)
+{
+    const __m128i keyv = _mm_set1_epi32(static_cast<int>(key));
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i m = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), keyv);
+        const __m128i mLo = _mm_cvtepi32_epi64(m);
+        const __m128i mHi = _mm_cvtepi32_epi64(_mm_srli_si128(m, 8));
+        const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 2));
+        acc = _mm_add_epi64(acc, _mm_and_si128(v0, mLo));
+        acc = _mm_add_epi64(acc, _mm_and_si128(v1, mHi));
+    }
+    alignas(16) std::int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + sumWhereScalar(values + i, keys + i, key, n - i);
+}
+
+ORDERS_TARGET("sse4.2")
+MinMax minMaxSse(const std::int64_t* values, const std::uint32_t* keys,
+                 std::uint32_t key, std::size_t n, bool negate)
+{
+    const __m128i keyv = _mm_set1_epi32(static_cast<int>(key));
+    const __m128i flip = negate ? _mm_set1_epi32(-1) : _mm_setzero_si128();
+    const __m128i hi = _mm_set1_epi64x(kInt64Max);
+    const __m128i lo = _mm_set1_epi64x(kInt64Min);
+    __m128i vmin = hi;
+    __m128i vmax = lo;
+    std::size_t count = 0;
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i m = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), keyv);
+        m = _mm_xor_si128(m, flip);
+        const unsigned bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+        if (bits == 0) {
+            continue;
+        }
+        count += static_cast<std::size_t>(popcount8(bits));
+
+        const __m128i mLo = _mm_cvtepi32_epi64(m);
+        const __m128i mHi = _mm_cvtepi32_epi64(_mm_srli_si128(m, 8));
+        const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 2));
+
+        // 不匹配的行替换为不影响结果的哨兵值
+        const __m128i min0 = _mm_blendv_epi8(hi, v0, mLo);
+        const __m128i min1 = _mm_blendv_epi8(hi, v1, mHi);
+        vmin = _mm_blendv_epi8(vmin, min0, _mm_cmpgt_epi64(vmin, min0));
+        vmin = _mm_blendv_epi8(vmin, min1, _mm_cmpgt_epi64(vmin, min1));
+
+        const __m128i max0 = _mm_blendv_epi8(lo, v0, mLo);
+        const __m128i max1 = _mm_blendv_epi8(lo, v1, mHi);
+        vmax = _mm_blendv_epi8(vmax, max0, _mm_cmpgt_epi64(max0, vmax));
+        vmax = _mm_blendv_epi8(vmax, max1, _mm_cmpgt_epi64(max1, vmax));
+    }
+
+    MinMax head;
+    if (count > 0) {
+        alignas(16) std::int64_t mins[2];
+        alignas(16) std::int64_t maxs[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(mins), vmin);
+        _mm_store_si128(reinterpret_cast<__m128i*>(maxs), vmax);
+        head.min = mins[0] < mins[1] ? mins[0] : mins[1];
+        head.max = maxs[0] > maxs[1] ? maxs[0] : maxs[1];
+        head.count = count;
+    }
+    return merge(head, minMaxScalar(values + i, keys + i, key, n - i, negate));
+}
+
+MinMax minMaxWhereSse(const std::int64_t* values, const std::uint32_t* keys,
+                      std::uint32_t key, std::size_t n)
+{
+    return minMaxSse(values, keys, key, n, false);
+}
+
+MinMax minMaxExceptSse(const std::int64_t* values, const std::uint32_t* keys,
+                       std::uint32_t excluded, std::size_t n)
+{
+    return minMaxSse(values, keys, excluded, n, true);
+}
+
+// =============================================================================
+// AVX2 实现：每次处理 8 行
+// =============================================================================
+
+ORDERS_TARGET("avx2")
+std::int64_t sumAvx2(const std::int64_t* values, std::size_t n)
+{
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4)));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumScalar(values + i, n - i);
+}
+
+ORDERS_TARGET("avx2")
+std::int64_t sumWhereAvx2(const std::int64_t* values, const std::uint32_t* keys,
+                          std::uint32_t key, std::size_t n)
+{
+    const __m256i keyv = _mm256_set1_epi32(static_cast<int>(key));
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i m = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), keyv);
+        const __m256i mLo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(m));
+        const __m256i mHi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(m, 1));
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4));
+        acc = _mm256_add_epi64(acc, _mm256_and_si256(v0, mLo));
+        acc = _mm256_add_epi64(acc, _mm256_and_si256(v1, mHi));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3]
+         + sumWhereScalar(values + i, keys + i, key, n - i);
+}
+
+ORDERS_TARGET("avx2")
+MinMax minMaxAvx2(const std::int64_t* values, const std::uint32_t* keys,
+                  std::uint32_t key, std::size_t n, bool negate)
+{
+    const __m256i keyv = _mm256_set1_epi32(static_cast<int>(key));
+    const __m256i flip = negate ? _mm256_set1_epi32(-1) : _mm256_setzero_si256();
+    const __m256i hi = _mm256_set1_epi64x(kInt64Max);
+    const __m256i lo = _mm256_set1_epi64x(kInt64Min);
+    __m256i vmin = hi;
+    __m256i vmax = lo;
+    std::size_t count = 0;
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i m = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), keyv);
+        m = _mm256_xor_si256(m, flip);
+        const unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+        if (bits == 0) {
+            continue;
+        }
+        count += static_cast<std::size_t>(popcount8(bits));
+
+        const __m256i mLo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(m));
+        const __m256i mHi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(m, 1));
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4));
+
+        // 不匹配的行替换为不影响结果的哨兵值
+        const __m256i min0 = _mm256_blendv_epi8(hi, v0, mLo);
+        const __m256i min1 = _mm256_blendv_epi8(hi, v1, mHi);
+        vmin = _mm256_blendv_epi8(vmin, min0, _mm256_cmpgt_epi64(vmin, min0));
+        vmin = _mm256_blendv_epi8(vmin, min1, _mm256_cmpgt_epi64(vmin, min1));
+
+        const __m256i max0 = _mm256_blendv_epi8(lo, v0, mLo);
+        const __m256i max1 = _mm256_blendv_epi8(lo, v1, mHi);
+        vmax = _mm256_blendv_epi8(vmax, max0, _mm256_cmpgt_epi64(max0, vmax));
+        vmax = _mm256_blendv_epi8(vmax, max1, _mm256_cmpgt_epi64(max1, vmax));
+    }
+
+    MinMax head;
+    if (count > 0) {
+        alignas(32) std::int64_t mins[4];
+        alignas(32) std::int64_t maxs[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(mins), vmin);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+        head.min = mins[0];
+        head.max = maxs[0];
+        for (int lane = 1; lane < 4; ++lane) {
+            if (mins[lane] < head.min) head.min = mins[lane];
+            if (maxs[lane] > head.max) head.max = maxs[lane];
+        }
+        head.count = count;
+    }
+    return merge(head, minMaxScalar(values + i, keys + i, key, n - i, negate));
+}
+
+MinMax minMaxWhereAvx2(const std::int64_t* values, const std::uint32_t* keys,
+                       std::uint32_t key, std::size_t n)
+{
+    return minMaxAvx2(values, keys, key, n, false);
+}
+
+MinMax minMaxExceptAvx2(const std::int64_t* values, const std::uint32_t* keys,
+                        std::uint32_t excluded, std::size_t n)
+{
+    return minMaxAvx2(values, keys, excluded, n, true);
+}
+
+// =============================================================================
+// CPU 特性检测
+// =============================================================================
+
+#if defined(_MSC_VER) && !defined(__clang__)
+bool cpuHasAvx2()
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;  // 操作系统未启用 YMM 寄存器状态保存
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+bool cpuHasSse42()
+{
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+}
+#else
+bool cpuHasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+bool cpuHasSse42()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+#endif
+
+#endif // ORDERS_KERNELS_X86
+
+// =============================================================================
+// 运行时分派
+// =============================================================================
+
+struct Dispatch {
+    std::int64_t (*sum)(const std::int64_t*, std::size_t);
+    std::int64_t (*sumWhere)(const std::int64_t*, const std::uint32_t*, std::uint32_t, std::size_t);
+    MinMax (*minMaxWhere)(const std::int64_t*, const std::uint32_t*, std::uint32_t, std::size_t);
+    MinMax (*minMaxExcept)(const std::int64_t*, const std::uint32_t*, std::uint32_t, std::size_t);
+    const char* name;
+};
+
+Dispatch selectDispatch()
+{
+#ifdef ORDERS_KERNELS_X86
+    if (cpuHasAvx2()) {
+        return {sumAvx2, sumWhereAvx2, minMaxWhereAvx2, minMaxExceptAvx2, "avx2"};
+    }
+    if (cpuHasSse42()) {
+        return {sumSse, sumWhereSse, minMaxWhereSse, minMaxExceptSse, "sse4.2"};
+    }
+#endif
+    return {sumScalar, sumWhereScalar, minMaxWhereScalar, minMaxExceptScalar, "scalar"};
+}
+
+const Dispatch& dispatch()
+{
+    static const Dispatch d = selectDispatch();
+    return d;
+}
+
+} // namespace
+
+std::int64_t sum(const std::int64_t* values, std::size_t n)
+{
+    return dispatch().sum(values, n);
+}
+
+std::int64_t sumWhere(const std::int64_t* values, const std::uint32_t* keys,
+                      std::uint32_t key, std::size_t n)
+{
+    return dispatch().sumWhere(values, keys, key, n);
+}
+
+MinMax minMaxWhere(const std::int64_t* values, const std::uint32_t* keys,
+                   std::uint32_t key, std::size_t n)
+{
+    return dispatch().minMaxWhere(values, keys, key, n);
+}
+
+MinMax minMaxExcept(const std::int64_t* values, const std::uint32_t* keys,
+                    std::uint32_t excluded, std::size_t n)
+{
+    return dispatch().minMaxExcept(values, keys, excluded, n);
+}
+
+const char* activeIsa()
+{
+    return dispatch().name;
+}
+
+} // namespace orders::kernels
@@ -1,60 +1,114 @@
 #include "order_model.h"
+#include "order_query.h"
 #include "orders_service.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace orders {
 
 OrderModel::OrderModel(QObject* parent)
     : QAbstractListModel(parent)
 {
+    m_requestTimer.setSingleShot(true);
+    m_requestTimer.setInterval(0);
+    connect(&m_requestTimer, &QTimer::timeout, this, &OrderModel::loadRequestedPages);
 }
 
 OrderModel::OrderModel(OrdersService* service, QObject* parent)
-    : QAbstractListModel(parent)
+    : OrderModel(parent)
 {
     setService(service);
 }
 
 OrderModel::~OrderModel() = default;
 
+namespace {
+
+QVariant orderData(const Order& order, int role)
+{
+    switch (role) {
+    case OrderModel::IdRole:
+        return order.id;
+    case OrderModel::CustomerNameRole:
+        return order.customerName;
+    case OrderModel::ProductNameRole:
+        return order.productName;
+    case OrderModel::QuantityRole:
+        return order.quantity;
+    case OrderModel::PriceRole:
+        return money::toMajor(order.priceMinor);
+    case OrderModel::StatusRole:
+        return order.status;
+    case OrderModel::CreatedAtRole:
+        return order.createdAt;
+    case OrderModel::UpdatedAtRole:
+        return order.updatedAt;
+    case OrderModel::TotalRole:
+        return money::toMajor(order.totalMinor());
+    default:
+        return QVariant();
+    }
+}
+
+} // namespace
+
 int OrderModel::rowCount(const QModelIndex& parent) const
 {
     if (parent.isValid()) return 0;
-    return m_filteredOrders.size();
+    return m_paged ? m_loadedRows : static_cast<int>(m_rowHandles.size());
 }
 
 QVariant OrderModel::data(const QModelIndex& index, int role) const
 {
-    if (!index.isValid() || index.row() >= m_filteredOrders.size()) {
+    if (!index.isValid() || !m_service || index.row() >= rowCount()) {
         return QVariant();
     }
 
-    const QVariantMap& order = m_filteredOrders.at(index.row()).toMap();
+    if (m_paged) {
+        const Order* order = pagedRow(index.row());
+        return order ? orderData(*order, role) : QVariant();  // page still loading
+    }
 
+    const OrderStore::Handle handle = m_rowHandles[static_cast<std::size_t>(index.row())];
+    if (!m_service->store().isAlive(handle)) {
+        return QVariant();
+    }
+    return roleData(m_service->store().at(handle), role);
+}
+
+QVariant OrderModel::roleData(const OrderView& order, int role)
+{
     switch (role) {
     case IdRole:
-        return order.value("id");
+        return order.id();
     case CustomerNameRole:
-        return order.value("customerName");
+        return order.customerName();
     case ProductNameRole:
-        return order.value("productName");
+        return order.productName();
     case QuantityRole:
-        return order.value("quantity");
+        return order.quantity();
     case PriceRole:
-        return order.value("price");
+        return order.price();
     case StatusRole:
-        return order.value("status");
+        return order.status();
     case CreatedAtRole:
-        return order.value("createdAt");
+        return order.createdAt();
     case UpdatedAtRole:
-        return order.value("updatedAt");
+        return order.updatedAt();
     case TotalRole:
-        return order.value("total");
+        return order.total();
     default:
         return QVariant();
     }
 }
 
 QHash<int, QByteArray> OrderModel::roleNames() const
+{
+    return orderRoleNames();
+}
+
+QHash<int, QByteArray> OrderModel::orderRoleNames()
 {
     return {
         {IdRole, "id"},
@@ -78,6 +132,23 @@ void OrderModel::setFilterStatus(const QString& status)
     }
 }
 
+void OrderModel::setSearchText(const QString& text)
+{
+    if (m_searchText != text) {
+        m_searchText = text;
+        updateFilteredOrders();
+        emit searchTextChanged();
+    }
+}
+
+void OrderModel::setResetThreshold(int threshold)
+{
+    if (m_resetThreshold != threshold) {
+        m_resetThreshold = threshold;
+        emit resetThresholdChanged();
+    }
+}
+
 void OrderModel::setService(OrdersService* service)
 {
     if (m_service == service) {
@@ -86,12 +157,13 @@ void OrderModel::setService(OrdersService* service)
 
     if (m_service) {
         disconnect(m_service, nullptr, this, nullptr);
+        m_service->cancelOrdersPages(this);
     }
 
     m_service = service;
 
     if (m_service) {
-        connect(m_service, &OrdersService::ordersChanged, this, &OrderModel::onOrdersChanged);
+        connect(m_service, &OrdersService::orderChanges, this, &OrderModel::onOrderChanges);
     }
 
     updateFilteredOrders();
@@ -105,31 +177,509 @@ void OrderModel::refresh()
 
 QVariantMap OrderModel::get(int index) const
 {
-    if (index < 0 || index >= m_filteredOrders.size()) {
+    if (!m_service || index < 0 || index >= rowCount()) {
         return {};
     }
-    return m_filteredOrders.at(index).toMap();
+    if (m_paged) {
+        const Order* order = pagedRow(index);
+        return order ? order->toVariantMap() : QVariantMap();
+    }
+    return m_service->store().at(m_rowHandles[static_cast<std::size_t>(index)]).toVariantMap();
 }
 
-void OrderModel::onOrdersChanged()
+void OrderModel::onOrderChanges(const OrderChangeSet& changes)
 {
-    updateFilteredOrders();
+    if (m_paged) {
+        // A remote source is authoritative; local edits do not affect it
+        if (m_sourceUrl.isEmpty()) {
+            applyPagedChanges(changes);
+        }
+        return;
+    }
+
+    if (changes.reset || changes.size() > m_resetThreshold) {
+        updateFilteredOrders();
+        return;
+    }
+
+    const int oldCount = rowCount();
+
+    // Rows read the store directly, so a compaction must be applied before
+    // anything else. Rows whose order was dropped become InvalidHandle (data()
+    // returns nothing for them) and are removed right away; the rest keep
+    // their relative order, so the list stays sorted. Handles in the change
+    // set are pre-compaction values and are translated the same way.
+    const bool compacted = !changes.remap.isEmpty();
+    if (compacted) {
+        for (OrderStore::Handle& handle : m_rowHandles) {
+            handle = changes.remap[handle];
+        }
+        for (int row = rowCount() - 1; row >= 0; --row) {
+            if (m_rowHandles[static_cast<std::size_t>(row)] == OrderStore::InvalidHandle) {
+                removeRow(row);
+            }
+        }
+    }
+
+    for (const OrderChange& change : changes.changes) {
+        const OrderStore::Handle handle = compacted ? changes.remap[change.handle] : change.handle;
+        if (handle == OrderStore::InvalidHandle) {
+            continue;  // removed (and compacted away) within this change set
+        }
+
+        switch (change.kind) {
+        case OrderChange::Kind::Inserted:
+            if (rowOf(handle) < 0 && matchesFilter(handle)) {
+                insertRow(handle);
+            }
+            break;
+        case OrderChange::Kind::Updated: {
+            const int row = rowOf(handle);
+            const bool matches = matchesFilter(handle);
+            if (row >= 0 && matches) {
+                const QList<int> roles = rolesFor(change.fields);
+                if (!roles.isEmpty()) {
+                    const QModelIndex idx = index(row);
+                    emit dataChanged(idx, idx, roles);
+                }
+            } else if (row >= 0) {
+                removeRow(row);   // no longer matches the filter
+            } else if (matches) {
+                insertRow(handle);
+            }
+            break;
+        }
+        case OrderChange::Kind::Removed: {
+            const int row = rowOf(handle);
+            if (row >= 0) {
+                removeRow(row);
+            }
+            break;
+        }
+        }
+    }
+
+    if (rowCount() != oldCount) {
+        emit countChanged();
+    }
+}
+
+bool OrderModel::matchesFilter(OrderStore::Handle handle) const
+{
+    const OrderStore& store = m_service->store();
+    if (!store.isAlive(handle)) {
+        return false;
+    }
+
+    const OrderView order = store.at(handle);
+    if (!m_filterStatus.isEmpty() && order.statusView() != m_filterStatus) {
+        return false;
+    }
+
+    const QString needle = m_searchText.trimmed();
+    return needle.isEmpty()
+        || order.customerNameView().contains(needle, Qt::CaseInsensitive)
+        || order.productNameView().contains(needle, Qt::CaseInsensitive);
+}
+
+bool OrderModel::matchesFilter(const Order& order) const
+{
+    if (!m_filterStatus.isEmpty() && order.status != m_filterStatus) {
+        return false;
+    }
+
+    const QString needle = m_searchText.trimmed();
+    return needle.isEmpty()
+        || order.customerName.contains(needle, Qt::CaseInsensitive)
+        || order.productName.contains(needle, Qt::CaseInsensitive);
+}
+
+int OrderModel::rowOf(OrderStore::Handle handle) const
+{
+    auto it = std::lower_bound(m_rowHandles.begin(), m_rowHandles.end(), handle);
+    if (it == m_rowHandles.end() || *it != handle) {
+        return -1;
+    }
+    return static_cast<int>(it - m_rowHandles.begin());
+}
+
+void OrderModel::insertRow(OrderStore::Handle handle)
+{
+    auto it = std::lower_bound(m_rowHandles.begin(), m_rowHandles.end(), handle);
+    const int row = static_cast<int>(it - m_rowHandles.begin());
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_rowHandles.insert(it, handle);
+    endInsertRows();
+}
+
+void OrderModel::removeRow(int row)
+{
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rowHandles.erase(m_rowHandles.begin() + row);
+    endRemoveRows();
+}
+
+QList<int> OrderModel::rolesFor(OrderFields fields)
+{
+    QList<int> roles;
+    if (fields & OrderField::CustomerName) roles << CustomerNameRole;
+    if (fields & OrderField::ProductName) roles << ProductNameRole;
+    if (fields & OrderField::Quantity) roles << QuantityRole;
+    if (fields & OrderField::Price) roles << PriceRole;
+    if (fields & OrderField::Status) roles << StatusRole;
+    if (fields & OrderField::CreatedAt) roles << CreatedAtRole;
+    if (fields & OrderField::UpdatedAt) roles << UpdatedAtRole;
+    if (fields & OrderField::Total) roles << TotalRole;
+    return roles;
 }
 
 void OrderModel::updateFilteredOrders()
 {
+    if (m_paged) {
+        m_rowHandles = {};
+        resetPages(0);
+        return;
+    }
+
     beginResetModel();
 
-    if (!m_service) {
-        m_filteredOrders = {};
-    } else if (m_filterStatus.isEmpty()) {
-        m_filteredOrders = m_service->getAllOrders();
-    } else {
-        m_filteredOrders = m_service->getOrdersByStatus(m_filterStatus);
+    m_rowHandles.clear();
+
+    if (m_service) {
+        const OrderStore& store = m_service->store();
+        const QString needle = m_searchText.trimmed();
+        if (!needle.isEmpty()) {
+            // Search hits come from the store's trigram index; the status
+            // filter is applied on top of the (usually small) hit list
+            m_rowHandles = store.search(needle, 0);
+            if (!m_filterStatus.isEmpty()) {
+                m_rowHandles.erase(std::remove_if(m_rowHandles.begin(), m_rowHandles.end(),
+                    [&](OrderStore::Handle h) { return store.at(h).statusView() != m_filterStatus; }),
+                    m_rowHandles.end());
+            }
+        } else if (m_filterStatus.isEmpty()) {
+            m_rowHandles.reserve(static_cast<std::size_t>(store.size()));
+            store.forEach([this](OrderStore::Handle h, const OrderView&) {
+                m_rowHandles.push_back(h);
+            });
+        } else {
+            m_rowHandles = store.handlesWithStatus(m_filterStatus);
+        }
     }
-    
+
     endResetModel();
     emit countChanged();
 }
 
+// =============================================================================
+// Paged mode
+// =============================================================================
+
+void OrderModel::setPaged(bool paged)
+{
+    if (m_paged != paged) {
+        m_paged = paged;
+        m_pages.clear();
+        updateFilteredOrders();
+        emit pagedChanged();
+    }
+}
+
+void OrderModel::setPageSize(int size)
+{
+    if (size > 0 && m_pages.pageSize() != size) {
+        m_pages.setPageSize(size);
+        if (m_paged) {
+            resetPages(0);
+        }
+        emit pageSizeChanged();
+    }
+}
+
+void OrderModel::setMaxCachedPages(int pages)
+{
+    if (pages > 0 && m_pages.capacity() != pages) {
+        m_pages.setCapacity(pages);
+        emit maxCachedPagesChanged();
+    }
+}
+
+void OrderModel::setSourceUrl(const QString& url)
+{
+    if (m_sourceUrl != url) {
+        m_sourceUrl = url;
+        if (m_paged) {
+            resetPages(0);
+        }
+        emit sourceUrlChanged();
+    }
+}
+
+bool OrderModel::canFetchMore(const QModelIndex& parent) const
+{
+    if (parent.isValid() || !m_paged || !m_service) {
+        return false;
+    }
+    if (m_totalRows >= 0 && m_loadedRows >= m_totalRows) {
+        return false;
+    }
+    return !m_pages.isPending(m_pages.pageOf(m_loadedRows));
+}
+
+void OrderModel::fetchMore(const QModelIndex& parent)
+{
+    if (canFetchMore(parent)) {
+        loadPage(m_pages.pageOf(m_loadedRows));
+    }
+}
+
+void OrderModel::resetPages(int keepRows)
+{
+    beginResetModel();
+    ++m_generation;
+    if (m_service) {
+        m_service->cancelOrdersPages(this);  // in-flight pages belong to the old generation
+    }
+    m_pages.clear();
+    m_requestedPages.clear();
+    m_totalRows = -1;
+    m_loadedRows = 0;
+    if (keepRows > 0 && m_service && m_sourceUrl.isEmpty()) {
+        // Local source: the total is cheap to recount, keep the scrolled-in window
+        OrderQuery query;
+        query.status = m_filterStatus;
+        query.search = m_searchText.trimmed();
+        query.limit = 1;
+        m_totalRows = m_service->store().query(query).total;
+        m_loadedRows = qMin(keepRows, m_totalRows);
+    }
+    endResetModel();
+    emit countChanged();
+}
+
+void OrderModel::loadPage(int page)
+{
+    if (!m_service || m_pages.hasPage(page) || m_pages.isPending(page)) {
+        return;
+    }
+    m_pages.markPending(page);
+
+    if (m_sourceUrl.isEmpty()) {
+        applyPage(m_generation, page, queryLocalPage(page));
+        return;
+    }
+
+    const QVariantMap params = {
+        {"status", m_filterStatus},
+        {"q", m_searchText.trimmed()}
+    };
+    const quint64 generation = m_generation;
+    m_service->fetchOrdersPage(m_sourceUrl, params, page * m_pages.pageSize(), m_pages.pageSize(), this,
+        [this, generation, page](const OrderPage& loaded) {
+            applyPage(generation, page, loaded);
+        });
+}
+
+void OrderModel::loadRequestedPages()
+{
+    const QSet<int> pages = std::exchange(m_requestedPages, {});
+    for (int page : pages) {
+        loadPage(page);
+    }
+}
+
+OrderPage OrderModel::queryLocalPage(int page) const
+{
+    // Local source: run the page through the store's query engine
+    OrderQuery query;
+    query.status = m_filterStatus;
+    query.search = m_searchText.trimmed();
+    query.offset = page * m_pages.pageSize();
+    query.limit = m_pages.pageSize();
+    const OrderStore& store = m_service->store();
+    const OrderQueryResult result = store.query(query);
+
+    OrderPage loaded;
+    loaded.ok = true;
+    loaded.total = result.total;
+    loaded.orders.reserve(static_cast<qsizetype>(result.handles.size()));
+    for (OrderStore::Handle h : result.handles) {
+        loaded.orders.append(store.at(h).toOrder());
+    }
+    return loaded;
+}
+
+void OrderModel::applyPage(quint64 generation, int page, const OrderPage& result)
+{
+    if (generation != m_generation) {
+        return;  // filter/source changed while the request was in flight
+    }
+    if (!result.ok) {
+        m_pages.cancel(page);
+        emit fetchFailed(result.error);
+        return;
+    }
+
+    const int first = page * m_pages.pageSize();
+    const int end = first + static_cast<int>(result.orders.size());
+    if (result.total >= 0) {
+        m_totalRows = result.total;
+    } else if (result.orders.size() < m_pages.pageSize()) {
+        m_totalRows = end;  // short page: the server has no more rows
+    }
+    m_pages.insert(page, result.orders);
+
+    const int exposed = m_loadedRows;
+    if (first < exposed) {
+        // A page scrolled back into view after eviction
+        emit dataChanged(index(first), index(qMin(end, exposed) - 1));
+    }
+    if (end > exposed) {
+        beginInsertRows(QModelIndex(), exposed, end - 1);
+        m_loadedRows = end;
+        endInsertRows();
+        emit countChanged();
+    }
+}
+
+const Order* OrderModel::pagedRow(int row) const
+{
+    const Order* order = m_pages.row(row);
+    if (order || !m_service) {
+        return order;
+    }
+
+    const int page = m_pages.pageOf(row);
+    if (m_sourceUrl.isEmpty()) {
+        // Local pages are a cheap store query: fill the cache in place and
+        // return the row right away
+        m_pages.markPending(page);  // makes it the anchor page, so it survives eviction
+        m_pages.insert(page, queryLocalPage(page).orders);
+        return m_pages.row(row);
+    }
+
+    // Remote pages: data() must not start requests or emit signals, so the
+    // page is requested from the event loop and announced via dataChanged()
+    if (!m_pages.isPending(page)) {
+        m_requestedPages.insert(page);
+        m_requestTimer.start();
+    }
+    return nullptr;
+}
+
+void OrderModel::applyPagedChanges(const OrderChangeSet& changes)
+{
+    if (changes.reset || changes.size() > m_resetThreshold) {
+        resetPages(m_loadedRows);
+        return;
+    }
+    if (m_totalRows < 0) {
+        return;  // nothing exposed yet: the first fetchMore() sees the new state
+    }
+
+    // Paged rows are Order values in store (handle) order. Compaction keeps
+    // that order and drops only removed orders, so a remap alone does not
+    // move any row; the change handles just need translating.
+    const OrderStore& store = m_service->store();
+    const bool compacted = !changes.remap.isEmpty();
+    const int oldCount = rowCount();
+
+    // Fields that decide whether an order matches the current filter
+    OrderFields filterFields;
+    if (!m_filterStatus.isEmpty()) filterFields |= OrderField::Status;
+    if (!m_searchText.trimmed().isEmpty()) filterFields |= OrderField::CustomerName | OrderField::ProductName;
+
+    // Removed orders are gone from the store; their last values come with the
+    // Deleted events and tell whether they were rows at all
+    QHash<QString, QVariantMap> deleted;
+    for (const OrderEvent& event : changes.events) {
+        if (event.type == OrderEvent::Type::Deleted) {
+            deleted.insert(event.id, event.before);
+        }
+    }
+
+    for (const OrderChange& change : changes.changes) {
+        const OrderStore::Handle handle = compacted ? changes.remap[change.handle] : change.handle;
+        // Pages are cached whole, so a cached row may lie past the exposed window
+        const int row = m_pages.findRow(change.id);
+        const bool exposed = row >= 0 && row < m_loadedRows;
+
+        switch (change.kind) {
+        case OrderChange::Kind::Inserted:
+            // New handles are always the largest, so a match becomes the last row
+            if (matchesFilter(handle)) {
+                insertPagedRow(m_totalRows);
+            }
+            continue;
+        case OrderChange::Kind::Updated: {
+            if (row < 0) {
+                if (!(change.fields & filterFields)) {
+                    continue;  // not cached and still (not) a row: loads fresh when viewed
+                }
+                break;  // may have entered or left the filter at an unknown row
+            }
+            if (!matchesFilter(handle)) {
+                removePagedRow(row);
+                continue;
+            }
+            m_pages.update(row, store.at(handle).toOrder());
+            const QList<int> roles = rolesFor(change.fields);
+            if (exposed && !roles.isEmpty()) {
+                const QModelIndex idx = index(row);
+                emit dataChanged(idx, idx, roles);
+            }
+            continue;
+        }
+        case OrderChange::Kind::Removed: {
+            if (row >= 0) {
+                removePagedRow(row);
+                continue;
+            }
+            const auto it = deleted.constFind(change.id);
+            if (it != deleted.constEnd() && !matchesFilter(Order::fromVariantMap(*it))) {
+                continue;  // never was a row
+            }
+            break;  // was a row in an uncached page
+        }
+        }
+
+        // Row position cannot be told from the cached pages: drop the cache but
+        // keep the exposed window, rows reload lazily as they are viewed
+        resetPages(m_loadedRows);
+        return;
+    }
+
+    if (rowCount() != oldCount) {
+        emit countChanged();
+    }
+}
+
+void OrderModel::insertPagedRow(int row)
+{
+    // Rows at and after the insert point shifted; those pages reload on demand
+    m_pages.dropFrom(m_pages.pageOf(row));
+    ++m_totalRows;
+    if (row <= m_loadedRows) {
+        beginInsertRows(QModelIndex(), row, row);
+        ++m_loadedRows;
+        endInsertRows();
+    }
+}
+
+void OrderModel::removePagedRow(int row)
+{
+    // Rows after the removed one shifted; those pages reload on demand
+    if (row >= m_loadedRows) {
+        m_pages.dropFrom(m_pages.pageOf(row));  // past the exposed window: no row to remove
+        --m_totalRows;
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    m_pages.dropFrom(m_pages.pageOf(row));
+    --m_totalRows;
+    --m_loadedRows;
+    endRemoveRows();
+}
+
 } // namespace orders
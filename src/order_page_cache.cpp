@@ -0,0 +1,98 @@
+#include "order_page_cache.h"
+
+#include <cstdlib>
+#include <iterator>
+
+namespace orders {
+
+OrderPageCache::OrderPageCache(int pageSize, int capacity)
+    : m_pageSize(qMax(1, pageSize))
+    , m_capacity(qMax(1, capacity))
+{
+}
+
+void OrderPageCache::setPageSize(int pageSize)
+{
+    m_pageSize = qMax(1, pageSize);
+    clear();
+}
+
+void OrderPageCache::setCapacity(int capacity)
+{
+    m_capacity = qMax(1, capacity);
+    evict();
+}
+
+const Order* OrderPageCache::row(int row)
+{
+    const int page = pageOf(row);
+    auto it = m_pages.constFind(page);
+    if (it == m_pages.constEnd()) {
+        return nullptr;
+    }
+
+    m_anchor = page;
+    const int offset = row - page * m_pageSize;
+    return offset < it.value().size() ? &it.value()[offset] : nullptr;
+}
+
+void OrderPageCache::insert(int page, QVector<Order> rows)
+{
+    m_pending.remove(page);
+    m_pages.insert(page, std::move(rows));
+    evict();
+}
+
+int OrderPageCache::findRow(const QString& id) const
+{
+    for (auto it = m_pages.constBegin(); it != m_pages.constEnd(); ++it) {
+        const QVector<Order>& rows = it.value();
+        for (qsizetype i = 0; i < rows.size(); ++i) {
+            if (rows[i].id == id) {
+                return it.key() * m_pageSize + static_cast<int>(i);
+            }
+        }
+    }
+    return -1;
+}
+
+void OrderPageCache::update(int row, Order order)
+{
+    const int page = pageOf(row);
+    auto it = m_pages.find(page);
+    const int offset = row - page * m_pageSize;
+    if (it != m_pages.end() && offset < it.value().size()) {
+        it.value()[offset] = std::move(order);
+    }
+}
+
+void OrderPageCache::dropFrom(int page)
+{
+    for (auto it = m_pages.begin(); it != m_pages.end();) {
+        it = it.key() >= page ? m_pages.erase(it) : std::next(it);
+    }
+    m_pending.removeIf([page](int pending) { return pending >= page; });
+}
+
+void OrderPageCache::clear()
+{
+    m_pages.clear();
+    m_pending.clear();
+    m_anchor = 0;
+}
+
+void OrderPageCache::evict()
+{
+    while (m_pages.size() > m_capacity) {
+        // 页数很少（容量量级），线性找最远页即可
+        auto farthest = m_pages.begin();
+        for (auto it = m_pages.begin(); it != m_pages.end(); ++it) {
+            if (std::abs(it.key() - m_anchor) > std::abs(farthest.key() - m_anchor)) {
+                farthest = it;
+            }
+        }
+        m_pages.erase(farthest);
+    }
+}
+
+} // namespace orders
@@ -0,0 +1,62 @@
+#include "order_query.h"
+
+#include <QDateTime>
+
+namespace orders {
+
+namespace {
+
+qint64 timeBound(const QVariantMap& map, const char* key)
+{
+    const QDateTime dt = map.value(QLatin1String(key)).toDateTime();
+    return dt.isValid() ? dt.toMSecsSinceEpoch() : OrderStore::NullTime;
+}
+
+} // namespace
+
+OrderQuery::SortKey OrderQuery::sortKeyFromString(const QString& name)
+{
+    static const QHash<QString, SortKey> keys = {
+        {QStringLiteral("id"), SortKey::Id},
+        {QStringLiteral("customerName"), SortKey::CustomerName},
+        {QStringLiteral("productName"), SortKey::ProductName},
+        {QStringLiteral("status"), SortKey::Status},
+        {QStringLiteral("quantity"), SortKey::Quantity},
+        {QStringLiteral("price"), SortKey::Price},
+        {QStringLiteral("total"), SortKey::Total},
+        {QStringLiteral("createdAt"), SortKey::CreatedAt},
+        {QStringLiteral("updatedAt"), SortKey::UpdatedAt},
+    };
+    return keys.value(name, SortKey::None);
+}
+
+OrderQuery OrderQuery::fromVariantMap(const QVariantMap& map)
+{
+    OrderQuery query;
+
+    const QVariantMap filter = map.value("filter").toMap();
+    query.status = filter.value("status").toString();
+    query.search = filter.value("search").toString().trimmed();
+    query.customerName = filter.value("customerName").toString();
+    query.productName = filter.value("productName").toString();
+    if (filter.contains("minTotal")) {
+        query.hasMinTotal = true;
+        query.minTotalMinor = money::fromMajor(filter.value("minTotal").toDouble());
+    }
+    if (filter.contains("maxTotal")) {
+        query.hasMaxTotal = true;
+        query.maxTotalMinor = money::fromMajor(filter.value("maxTotal").toDouble());
+    }
+    query.createdFromMs = timeBound(filter, "createdFrom");
+    query.createdToMs = timeBound(filter, "createdTo");
+    query.updatedFromMs = timeBound(filter, "updatedFrom");
+    query.updatedToMs = timeBound(filter, "updatedTo");
+
+    query.sortBy = sortKeyFromString(map.value("sortBy").toString());
+    query.descending = map.value("descending", false).toBool();
+    query.offset = qMax(0, map.value("offset", 0).toInt());
+    query.limit = map.value("limit", kDefaultLimit).toInt();
+    return query;
+}
+
+} // namespace orders
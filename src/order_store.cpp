@@ -0,0 +1,641 @@
+#include "order_store.h"
+#include "order_kernels.h"
+#include "order_query.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <utility>
+
+namespace orders {
+
+namespace {
+
+// 键列直接交给 order_kernels，类型必须一致（不做指针转换）
+static_assert(std::is_same_v<StringPool::Id, std::uint32_t>, "StringPool::Id must be std::uint32_t");
+
+// 只对结果中 [from, to) 这一段排序：前 from 个元素只需落在正确的一侧
+template <typename Less>
+void sortWindow(std::vector<quint32>& rows, std::size_t from, std::size_t to, Less less)
+{
+    if (from > 0) {
+        std::nth_element(rows.begin(), rows.begin() + from, rows.end(), less);
+    }
+    std::partial_sort(rows.begin() + from, rows.begin() + to, rows.end(), less);
+}
+
+// 排序键相同时按 Handle 升序，保证分页结果确定
+template <typename Key>
+auto byKey(Key key, bool descending)
+{
+    return [key, descending](quint32 a, quint32 b) {
+        const int c = key(a, b);
+        if (c != 0) {
+            return descending ? c > 0 : c < 0;
+        }
+        return a < b;
+    };
+}
+
+template <typename T>
+int compareValues(T a, T b)
+{
+    return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+} // namespace
+
+// =============================================================================
+// OrderView
+// =============================================================================
+
+Order OrderView::toOrder() const
+{
+    Order order;
+    order.id = id();
+    order.customerName = customerName();
+    order.productName = productName();
+    order.quantity = quantity();
+    order.priceMinor = priceMinor();
+    order.status = status();
+    order.createdAt = createdAt();
+    order.updatedAt = updatedAt();
+    return order;
+}
+
+// =============================================================================
+// OrderStore
+// =============================================================================
+
+OrderStore::Handle OrderStore::insert(const Order& order)
+{
+    if (m_index.contains(order.id)) {
+        return InvalidHandle;
+    }
+
+    const Handle handle = slotCount();
+    m_ids.push_back(m_idArena.store(order.id));
+    m_customer.push_back(StringPool::InvalidId);
+    m_product.push_back(StringPool::InvalidId);
+    m_status.push_back(StringPool::InvalidId);
+    m_quantity.push_back(0);
+    m_priceMinor.push_back(0);
+    m_lineTotal.push_back(0);
+    m_createdAt.push_back(NullTime);
+    m_updatedAt.push_back(NullTime);
+    m_contentHash.push_back(0);
+    m_alive.push_back(1);
+    writeRow(handle, order);
+
+    m_index.insert(m_ids[handle], handle);
+    addToBucket(m_statusIndex, m_status[handle], handle);
+    addToBucket(m_customerRows, m_customer[handle], handle);
+    addToBucket(m_productRows, m_product[handle], handle);
+    indexTime(m_createdIndex, m_createdAt[handle], handle);
+    indexTime(m_updatedIndex, m_updatedAt[handle], handle);
+    m_aggregates.add(m_status[handle], m_lineTotal[handle]);
+    ++m_liveCount;
+    return handle;
+}
+
+bool OrderStore::update(Handle handle, const Order& order)
+{
+    if (!isAlive(handle) || m_ids[handle] != order.id) {
+        return false;
+    }
+
+    const StringPool::Id oldCustomer = m_customer[handle];
+    const StringPool::Id oldProduct = m_product[handle];
+    const StringPool::Id oldStatus = m_status[handle];
+    const qint64 oldCreated = m_createdAt[handle];
+    const qint64 oldUpdated = m_updatedAt[handle];
+    m_aggregates.remove(oldStatus, m_lineTotal[handle]);
+
+    writeRow(handle, order);
+
+    if (m_customer[handle] != oldCustomer) {
+        dropFromBucket(m_customerRows, m_customer, oldCustomer);
+        addToBucket(m_customerRows, m_customer[handle], handle);
+    }
+    if (m_product[handle] != oldProduct) {
+        dropFromBucket(m_productRows, m_product, oldProduct);
+        addToBucket(m_productRows, m_product[handle], handle);
+    }
+    if (m_status[handle] != oldStatus) {
+        dropFromBucket(m_statusIndex, m_status, oldStatus);
+        addToBucket(m_statusIndex, m_status[handle], handle);
+    }
+    if (m_createdAt[handle] != oldCreated) {
+        unindexTime(m_createdIndex, oldCreated, handle);
+        indexTime(m_createdIndex, m_createdAt[handle], handle);
+    }
+    if (m_updatedAt[handle] != oldUpdated) {
+        unindexTime(m_updatedIndex, oldUpdated, handle);
+        indexTime(m_updatedIndex, m_updatedAt[handle], handle);
+    }
+    m_aggregates.add(m_status[handle], m_lineTotal[handle]);
+    return true;
+}
+
+const std::vector<OrderStore::Handle>& OrderStore::handlesWithStatus(const QString& status) const
+{
+    return bucketRows(m_statusIndex, m_status, m_strings.find(status));
+}
+
+std::vector<OrderStore::Handle> OrderStore::search(QStringView query, int limit) const
+{
+    const QStringView needle = query.trimmed();
+    if (needle.isEmpty()) {
+        return {};
+    }
+
+    // 1. 找出包含查询串的客户名/产品名（驻留字符串，数量远小于订单数）
+    std::vector<StringPool::Id> matched;
+    const auto matches = [&](StringPool::Id id) {
+        return m_strings.view(id).contains(needle, Qt::CaseInsensitive);
+    };
+    if (needle.size() >= TrigramIndex::kGramSize) {
+        for (StringPool::Id id : m_search.candidates(needle)) {
+            if (matches(id)) {
+                matched.push_back(id);
+            }
+        }
+    } else {
+        // 查询串太短无法拆出 trigram，退化为扫描驻留池（只看被索引过的名字）
+        const StringPool::Id n = static_cast<StringPool::Id>(m_strings.size());
+        for (StringPool::Id id = 0; id < n; ++id) {
+            if (m_search.contains(id) && matches(id)) {
+                matched.push_back(id);
+            }
+        }
+    }
+
+    // 2. 收集这些名字对应的行号桶（均为升序）
+    std::vector<const std::vector<Handle>*> lists;
+    for (StringPool::Id id : matched) {
+        for (const std::vector<Handle>* rows : {&bucketRows(m_customerRows, m_customer, id),
+                                                &bucketRows(m_productRows, m_product, id)}) {
+            if (!rows->empty()) {
+                lists.push_back(rows);
+            }
+        }
+    }
+
+    // 3. 多路归并：结果按 Handle（插入顺序）升序、去重，凑满 limit 即停止
+    using Cursor = std::pair<Handle, std::size_t>;  // (当前 Handle, 列表下标)
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+    std::vector<std::size_t> positions(lists.size(), 0);
+    for (std::size_t i = 0; i < lists.size(); ++i) {
+        heap.emplace(lists[i]->front(), i);
+    }
+
+    std::vector<Handle> result;
+    while (!heap.empty() && (limit <= 0 || static_cast<int>(result.size()) < limit)) {
+        const auto [handle, list] = heap.top();
+        heap.pop();
+        if (result.empty() || result.back() != handle) {
+            result.push_back(handle);
+        }
+        if (++positions[list] < lists[list]->size()) {
+            heap.emplace((*lists[list])[positions[list]], list);
+        }
+    }
+    return result;
+}
+
+OrderQueryResult OrderStore::query(const OrderQuery& q) const
+{
+    OrderQueryResult result;
+
+    // 精确匹配的字符串先换成驻留 ID，不存在的值直接返回空结果
+    const auto resolve = [this](const QString& value, StringPool::Id* id) {
+        *id = value.isEmpty() ? StringPool::InvalidId : m_strings.find(value);
+        return value.isEmpty() || *id != StringPool::InvalidId;
+    };
+    StringPool::Id statusId, customerId, productId;
+    if (!resolve(q.status, &statusId) || !resolve(q.customerName, &customerId)
+        || !resolve(q.productName, &productId)) {
+        return result;
+    }
+
+    // 1. 候选集：选最窄的索引，其余条件逐行校验
+    const std::vector<Handle>* source = nullptr;  // nullptr 表示全表扫描
+    for (const std::vector<Handle>* b : {
+             statusId != StringPool::InvalidId ? &bucketRows(m_statusIndex, m_status, statusId) : nullptr,
+             customerId != StringPool::InvalidId ? &bucketRows(m_customerRows, m_customer, customerId) : nullptr,
+             productId != StringPool::InvalidId ? &bucketRows(m_productRows, m_product, productId) : nullptr}) {
+        if (b && (!source || b->size() < source->size())) {
+            source = b;
+        }
+    }
+
+    std::vector<Handle> scratch;
+    bool handleOrdered = true;  // 候选集是否按 Handle 升序
+    if (!source && !q.search.isEmpty()) {
+        scratch = search(q.search, 0);
+        source = &scratch;
+    } else if (!source && (q.createdFromMs != NullTime || q.createdToMs != NullTime)) {
+        scratch = handlesCreatedBetween(q.createdFromMs != NullTime ? q.createdFromMs : NullTime + 1,
+                                        q.createdToMs != NullTime ? q.createdToMs : std::numeric_limits<qint64>::max());
+        source = &scratch;
+        handleOrdered = false;
+    } else if (!source && (q.updatedFromMs != NullTime || q.updatedToMs != NullTime)) {
+        scratch = handlesUpdatedBetween(q.updatedFromMs != NullTime ? q.updatedFromMs : NullTime + 1,
+                                        q.updatedToMs != NullTime ? q.updatedToMs : std::numeric_limits<qint64>::max());
+        source = &scratch;
+        handleOrdered = false;
+    }
+
+    const auto inRange = [](qint64 t, qint64 from, qint64 to) {
+        if (from == NullTime && to == NullTime) {
+            return true;
+        }
+        return t != NullTime && (from == NullTime || t >= from) && (to == NullTime || t < to);
+    };
+    const auto matches = [&](Handle h) {
+        return m_alive[h]
+            && (statusId == StringPool::InvalidId || m_status[h] == statusId)
+            && (customerId == StringPool::InvalidId || m_customer[h] == customerId)
+            && (productId == StringPool::InvalidId || m_product[h] == productId)
+            && (!q.hasMinTotal || m_lineTotal[h] >= q.minTotalMinor)
+            && (!q.hasMaxTotal || m_lineTotal[h] <= q.maxTotalMinor)
+            && inRange(m_createdAt[h], q.createdFromMs, q.createdToMs)
+            && inRange(m_updatedAt[h], q.updatedFromMs, q.updatedToMs)
+            && (q.search.isEmpty()
+                || m_strings.view(m_customer[h]).contains(q.search, Qt::CaseInsensitive)
+                || m_strings.view(m_product[h]).contains(q.search, Qt::CaseInsensitive));
+    };
+
+    std::vector<Handle> rows;
+    if (source) {
+        rows.reserve(source->size());
+        for (Handle h : *source) {
+            if (matches(h)) {
+                rows.push_back(h);
+            }
+        }
+    } else {
+        rows.reserve(static_cast<std::size_t>(m_liveCount));
+        const Handle n = slotCount();
+        for (Handle h = 0; h < n; ++h) {
+            if (matches(h)) {
+                rows.push_back(h);
+            }
+        }
+    }
+    result.total = static_cast<int>(rows.size());
+
+    // 2. 分页窗口
+    const std::size_t from = std::min(rows.size(), static_cast<std::size_t>(q.offset));
+    const std::size_t to = q.limit > 0 ? std::min(rows.size(), from + static_cast<std::size_t>(q.limit))
+                                       : rows.size();
+    if (from == to) {
+        return result;
+    }
+
+    // 3. 只对窗口排序
+    switch (q.sortBy) {
+    case OrderQuery::SortKey::None:
+        if (handleOrdered && q.descending) {
+            // 候选集已按 Handle 有序，倒序时窗口从末尾数起，无需排序
+            result.handles.assign(rows.rbegin() + from, rows.rbegin() + to);
+            return result;
+        }
+        if (!handleOrdered) {
+            sortWindow(rows, from, to, [descending = q.descending](Handle a, Handle b) {
+                return descending ? a > b : a < b;
+            });
+        }
+        break;
+    case OrderQuery::SortKey::Id:
+        sortWindow(rows, from, to, byKey([this](Handle a, Handle b) {
+            return m_ids[a].compare(m_ids[b]);
+        }, q.descending));
+        break;
+    case OrderQuery::SortKey::CustomerName:
+    case OrderQuery::SortKey::ProductName:
+    case OrderQuery::SortKey::Status: {
+        const std::vector<StringPool::Id>& column = q.sortBy == OrderQuery::SortKey::CustomerName ? m_customer
+            : q.sortBy == OrderQuery::SortKey::ProductName ? m_product : m_status;
+        sortWindow(rows, from, to, byKey([this, &column](Handle a, Handle b) {
+            return column[a] == column[b] ? 0
+                : m_strings.view(column[a]).compare(m_strings.view(column[b]), Qt::CaseInsensitive);
+        }, q.descending));
+        break;
+    }
+    case OrderQuery::SortKey::Quantity:
+        sortWindow(rows, from, to, byKey([this](Handle a, Handle b) {
+            return compareValues(m_quantity[a], m_quantity[b]);
+        }, q.descending));
+        break;
+    case OrderQuery::SortKey::Price:
+    case OrderQuery::SortKey::Total:
+    case OrderQuery::SortKey::CreatedAt:
+    case OrderQuery::SortKey::UpdatedAt: {
+        const std::vector<std::int64_t>& column = q.sortBy == OrderQuery::SortKey::Price ? m_priceMinor
+            : q.sortBy == OrderQuery::SortKey::Total ? m_lineTotal
+            : q.sortBy == OrderQuery::SortKey::CreatedAt ? m_createdAt : m_updatedAt;
+        sortWindow(rows, from, to, byKey([&column](Handle a, Handle b) {
+            return compareValues(column[a], column[b]);
+        }, q.descending));
+        break;
+    }
+    }
+
+    result.handles.assign(rows.begin() + from, rows.begin() + to);
+    return result;
+}
+
+OrderStore::RevenueStats OrderStore::revenueStats() const
+{
+    const kernels::MinMax mm = kernels::minMaxExcept(
+        m_lineTotal.data(), m_status.data(), StringPool::InvalidId, m_lineTotal.size());
+
+    RevenueStats stats;
+    stats.count = static_cast<int>(mm.count);
+    stats.sumMinor = kernels::sum(m_lineTotal.data(), m_lineTotal.size());  // 墓碑行金额为 0
+    if (mm.count > 0) {
+        stats.minMinor = mm.min;
+        stats.maxMinor = mm.max;
+    }
+    return stats;
+}
+
+OrderStore::RevenueStats OrderStore::revenueStats(const QString& status) const
+{
+    RevenueStats stats;
+    const StringPool::Id key = m_strings.find(status);
+    if (key == StringPool::InvalidId) {
+        return stats;
+    }
+
+    const kernels::MinMax mm = kernels::minMaxWhere(
+        m_lineTotal.data(), m_status.data(), key, m_lineTotal.size());
+    stats.count = static_cast<int>(mm.count);
+    stats.sumMinor = kernels::sumWhere(m_lineTotal.data(), m_status.data(), key, m_lineTotal.size());
+    if (mm.count > 0) {
+        stats.minMinor = mm.min;
+        stats.maxMinor = mm.max;
+    }
+    return stats;
+}
+
+bool OrderStore::remove(Handle handle)
+{
+    if (!isAlive(handle)) {
+        return false;
+    }
+
+    const StringPool::Id status = m_status[handle];
+    m_index.remove(m_ids[handle]);
+    unindexTime(m_createdIndex, m_createdAt[handle], handle);
+    unindexTime(m_updatedIndex, m_updatedAt[handle], handle);
+    m_aggregates.remove(status, m_lineTotal[handle]);
+    m_ids[handle] = QStringView();  // 字符内容留在块中，压缩或 clear() 时回收
+    // 墓碑行不参与列扫描：金额清零，状态键置为保留值
+    m_status[handle] = StringPool::InvalidId;
+    m_lineTotal[handle] = 0;
+    m_alive[handle] = 0;
+    --m_liveCount;
+
+    // 行号桶中的这一项在读取或压缩时过滤
+    dropFromBucket(m_statusIndex, m_status, status);
+    dropFromBucket(m_customerRows, m_customer, m_customer[handle]);
+    dropFromBucket(m_productRows, m_product, m_product[handle]);
+    return true;
+}
+
+void OrderStore::clear()
+{
+    m_ids.clear();
+    m_customer.clear();
+    m_product.clear();
+    m_status.clear();
+    m_quantity.clear();
+    m_priceMinor.clear();
+    m_lineTotal.clear();
+    m_createdAt.clear();
+    m_updatedAt.clear();
+    m_contentHash.clear();
+    m_alive.clear();
+
+    m_idArena.reset();
+    m_strings.clear();
+    m_index.clear();
+    m_statusIndex.clear();
+    m_customerRows.clear();
+    m_productRows.clear();
+    m_search.clear();
+    m_createdIndex.clear();
+    m_updatedIndex.clear();
+    m_aggregates.clear();
+    m_liveCount = 0;
+}
+
+void OrderStore::reserve(int rows)
+{
+    const std::size_t n = static_cast<std::size_t>(rows);
+    m_ids.reserve(n);
+    m_customer.reserve(n);
+    m_product.reserve(n);
+    m_status.reserve(n);
+    m_quantity.reserve(n);
+    m_priceMinor.reserve(n);
+    m_lineTotal.reserve(n);
+    m_createdAt.reserve(n);
+    m_updatedAt.reserve(n);
+    m_contentHash.reserve(n);
+    m_alive.reserve(n);
+    m_index.reserve(rows);
+}
+
+bool OrderStore::needsCompaction() const
+{
+    const int tombstones = static_cast<int>(m_ids.size()) - m_liveCount;
+    return tombstones >= kMinTombstonesForCompaction && tombstones > m_liveCount;
+}
+
+QVector<OrderStore::Handle> OrderStore::compact()
+{
+    QVector<Handle> remap(static_cast<qsizetype>(m_ids.size()), InvalidHandle);
+
+    // 存活 ID 拷贝到新的字符串块中，已删除 ID 占用的空间随旧块一起释放
+    StringArena idArena;
+    m_index.clear();
+    m_index.reserve(m_liveCount);
+
+    Handle next = 0;
+    const Handle n = slotCount();
+    for (Handle h = 0; h < n; ++h) {
+        if (!m_alive[h]) {
+            continue;
+        }
+        m_ids[next] = idArena.store(m_ids[h]);
+        m_index.insert(m_ids[next], next);
+        if (next != h) {
+            m_customer[next] = m_customer[h];
+            m_product[next] = m_product[h];
+            m_status[next] = m_status[h];
+            m_quantity[next] = m_quantity[h];
+            m_priceMinor[next] = m_priceMinor[h];
+            m_lineTotal[next] = m_lineTotal[h];
+            m_createdAt[next] = m_createdAt[h];
+            m_updatedAt[next] = m_updatedAt[h];
+            m_contentHash[next] = m_contentHash[h];
+        }
+        remap[h] = next++;
+    }
+
+    m_ids.resize(next);
+    m_customer.resize(next);
+    m_product.resize(next);
+    m_status.resize(next);
+    m_quantity.resize(next);
+    m_priceMinor.resize(next);
+    m_lineTotal.resize(next);
+    m_createdAt.resize(next);
+    m_updatedAt.resize(next);
+    m_contentHash.resize(next);
+    m_alive.assign(next, 1);
+    m_idArena = std::move(idArena);
+
+    // 重映射保持单调，行号桶的有序部分仍然有序；失效项在这里一并过滤
+    remapBuckets(m_statusIndex, m_status, remap);
+    remapBuckets(m_customerRows, m_customer, remap);
+    remapBuckets(m_productRows, m_product, remap);
+    m_createdIndex.remap(remap);
+    m_updatedIndex.remap(remap);
+    return remap;
+}
+
+void OrderStore::writeRow(Handle handle, const Order& order)
+{
+    m_customer[handle] = m_strings.intern(order.customerName);
+    m_product[handle] = m_strings.intern(order.productName);
+    // 搜索索引按驻留字符串建立，已索引过的名字直接跳过
+    m_search.add(m_customer[handle], m_strings.view(m_customer[handle]));
+    m_search.add(m_product[handle], m_strings.view(m_product[handle]));
+    m_status[handle] = m_strings.intern(order.status);
+    m_quantity[handle] = order.quantity;
+    m_priceMinor[handle] = order.priceMinor;
+    m_lineTotal[handle] = order.totalMinor();
+    m_createdAt[handle] = toMs(order.createdAt);
+    m_updatedAt[handle] = toMs(order.updatedAt);
+    m_contentHash[handle] = contentHash(order);
+}
+
+size_t OrderStore::contentHash(const Order& order)
+{
+    return qHashMulti(0, order.customerName, order.productName, order.quantity, order.priceMinor,
+                      order.status, toMs(order.createdAt), toMs(order.updatedAt));
+}
+
+void OrderStore::indexTime(TimeIndex& index, qint64 timeMs, Handle handle)
+{
+    if (timeMs != NullTime) {
+        index.insert(timeMs, handle);
+    }
+}
+
+void OrderStore::unindexTime(TimeIndex& index, qint64 timeMs, Handle handle)
+{
+    if (timeMs != NullTime) {
+        index.remove(timeMs, handle);
+    }
+}
+
+void OrderStore::addToBucket(RowBuckets& buckets, StringPool::Id key, Handle handle)
+{
+    RowBucket& bucket = buckets[key];
+    // 新订单的 Handle 总是最大的，绝大多数情况下追加后仍然有序
+    if (bucket.sorted == bucket.rows.size() && (bucket.rows.empty() || bucket.rows.back() < handle)) {
+        ++bucket.sorted;
+    }
+    bucket.rows.push_back(handle);
+}
+
+void OrderStore::dropFromBucket(RowBuckets& buckets, const std::vector<StringPool::Id>& column,
+                                StringPool::Id key) const
+{
+    auto it = buckets.find(key);
+    if (it == buckets.end()) {
+        return;
+    }
+
+    // 调用时行的列值已不再是 key（或已成为墓碑），整理时会被过滤
+    RowBucket& bucket = it.value();
+    ++bucket.stale;
+    if (bucket.stale >= kMinStaleForSettle && bucket.stale * 2 > bucket.rows.size()) {
+        settleBucket(bucket, column, key);
+        if (bucket.rows.empty()) {
+            buckets.erase(it);
+        }
+    }
+}
+
+const std::vector<OrderStore::Handle>& OrderStore::bucketRows(RowBuckets& buckets,
+                                                              const std::vector<StringPool::Id>& column,
+                                                              StringPool::Id key) const
+{
+    static const std::vector<Handle> empty;
+    auto it = buckets.find(key);
+    if (it == buckets.end()) {
+        return empty;
+    }
+    settleBucket(it.value(), column, key);
+    return it.value().rows;
+}
+
+void OrderStore::settleBucket(RowBucket& bucket, const std::vector<StringPool::Id>& column,
+                              StringPool::Id key) const
+{
+    if (bucket.isSettled()) {
+        return;
+    }
+
+    // 乱序部分排序后与有序部分归并：O(n + t log t)，t 为两次整理之间追加的项数
+    std::vector<Handle>& rows = bucket.rows;
+    const auto tail = rows.begin() + static_cast<std::ptrdiff_t>(bucket.sorted);
+    std::sort(tail, rows.end());
+    std::inplace_merge(rows.begin(), tail, rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());  // 离开后又回到本桶的行
+    rows.erase(std::remove_if(rows.begin(), rows.end(), [this, &column, key](Handle h) {
+        return !m_alive[h] || column[h] != key;
+    }), rows.end());
+
+    bucket.sorted = rows.size();
+    bucket.stale = 0;
+}
+
+void OrderStore::remapBuckets(RowBuckets& buckets, const std::vector<StringPool::Id>& column,
+                              const QVector<Handle>& remap)
+{
+    for (auto it = buckets.begin(); it != buckets.end();) {
+        RowBucket& bucket = it.value();
+        std::size_t sorted = 0;
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < bucket.rows.size(); ++i) {
+            const Handle h = remap[bucket.rows[i]];
+            if (h == InvalidHandle || column[h] != it.key()) {
+                continue;  // 已删除，或已移到其他桶
+            }
+            bucket.rows[kept++] = h;
+            if (i < bucket.sorted) {
+                sorted = kept;
+            }
+        }
+        bucket.rows.resize(kept);
+        bucket.sorted = sorted;
+        bucket.stale = 0;
+        settleBucket(bucket, column, it.key());
+
+        if (bucket.rows.empty()) {
+            it = buckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace orders
@@ -0,0 +1,112 @@
+#include "order_wire.h"
+
+#include <QCborStreamWriter>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace orders {
+
+// =============================================================================
+// JSON
+// =============================================================================
+
+/**
+ * @brief 从 JSON 对象创建 Order 结构体
+ *
+ * 与 fromVariantMap 的字段映射保持一致；时间为 ISO 8601 字符串
+ */
+Order Order::fromJson(const QJsonObject& object)
+{
+    Order order;
+    order.id = object.value(QLatin1String("id")).toString();
+    order.customerName = object.value(QLatin1String("customerName")).toString();
+    order.productName = object.value(QLatin1String("productName")).toString();
+    order.quantity = object.value(QLatin1String("quantity")).toInt();
+    order.priceMinor = money::fromMajor(object.value(QLatin1String("price")).toDouble());
+    order.status = object.value(QLatin1String("status")).toString(QStringLiteral("pending"));
+    order.createdAt = QDateTime::fromString(object.value(QLatin1String("createdAt")).toString(), Qt::ISODateWithMs);
+    order.updatedAt = QDateTime::fromString(object.value(QLatin1String("updatedAt")).toString(), Qt::ISODateWithMs);
+    return order;
+}
+
+namespace wire {
+
+QJsonObject toJson(const Order& order)
+{
+    return {
+        {QLatin1String("id"), order.id},
+        {QLatin1String("customerName"), order.customerName},
+        {QLatin1String("productName"), order.productName},
+        {QLatin1String("quantity"), order.quantity},
+        {QLatin1String("price"), money::toMajor(order.priceMinor)},
+        {QLatin1String("status"), order.status},
+        {QLatin1String("createdAt"), order.createdAt.toString(Qt::ISODateWithMs)},
+        {QLatin1String("updatedAt"), order.updatedAt.toString(Qt::ISODateWithMs)}
+    };
+}
+
+QByteArray encodeJson(const QList<Order>& orders)
+{
+    QJsonArray array;
+    for (const Order& order : orders) {
+        array.append(toJson(order));
+    }
+    return QJsonDocument(array).toJson(QJsonDocument::Compact);
+}
+
+// =============================================================================
+// CBOR
+// =============================================================================
+
+QString acceptHeader(bool preferCbor)
+{
+    if (!preferCbor) {
+        return QString::fromLatin1(kJsonMimeType);
+    }
+    return QStringLiteral("%1, %2;q=0.9").arg(QLatin1String(kCborMimeType), QLatin1String(kJsonMimeType));
+}
+
+bool isCbor(const QByteArray& contentType)
+{
+    const qsizetype semicolon = contentType.indexOf(';');
+    const QByteArray mime = (semicolon < 0 ? contentType : contentType.left(semicolon)).trimmed().toLower();
+    return mime == kCborMimeType;
+}
+
+void writeOrder(QCborStreamWriter& writer, const Order& order)
+{
+    const auto key = [&writer](Key k) { writer.append(static_cast<quint64>(k)); };
+    const auto time = [&writer](const QDateTime& dt) {
+        if (dt.isValid()) {
+            writer.append(dt.toMSecsSinceEpoch());
+        } else {
+            writer.appendNull();
+        }
+    };
+
+    writer.startMap(8);
+    key(Key::Id);           writer.append(order.id);
+    key(Key::CustomerName); writer.append(order.customerName);
+    key(Key::ProductName);  writer.append(order.productName);
+    key(Key::Quantity);     writer.append(static_cast<qint64>(order.quantity));
+    key(Key::PriceMinor);   writer.append(order.priceMinor);
+    key(Key::Status);       writer.append(order.status);
+    key(Key::CreatedAt);    time(order.createdAt);
+    key(Key::UpdatedAt);    time(order.updatedAt);
+    writer.endMap();
+}
+
+QByteArray encodeCbor(const QList<Order>& orders)
+{
+    QByteArray data;
+    QCborStreamWriter writer(&data);
+    writer.startArray(static_cast<quint64>(orders.size()));
+    for (const Order& order : orders) {
+        writeOrder(writer, order);
+    }
+    writer.endArray();
+    return data;
+}
+
+} // namespace wire
+} // namespace orders
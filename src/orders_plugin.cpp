@@ -25,7 +25,11 @@
 #include "orders_plugin.h"
 #include "orders_service.h"
 #include "order_model.h"
+#include "sorted_order_model.h"
+#include "group_summary_model.h"
 #include "demo_service.h"
+#include "refresh_scheduler.h"
+#include "response_cache.h"
 
 // MPF SDK 头文件
 #include <mpf/service_registry.h>        // 服务注册表
@@ -93,9 +97,27 @@ bool OrdersPlugin::initialize(mpf::ServiceRegistry* registry)
     // -------------------------------------------------------------------------
     m_ordersService = std::make_unique<OrdersService>(this);
 
+    // -------------------------------------------------------------------------
+    // 【刷新调度】
+    // 徽章、统计卡片等派生状态只需反映最新值：
+    // 数据变化只标记“待刷新”，由调度器合并并限制为每秒最多 kRefreshMaxHz 次，
+    // 批量导入或整体加载时不会对宿主产生成千上万次跨插件调用
+    // -------------------------------------------------------------------------
+    m_refreshScheduler = std::make_unique<RefreshScheduler>(kRefreshMaxHz);
+    m_ordersService->setRefreshScheduler(m_refreshScheduler.get());
+
     // Demo service for framework showcase
     m_demoService = std::make_unique<DemoService>("com.yourco.orders", this);
 
+    // -------------------------------------------------------------------------
+    // 【响应缓存】
+    // 两个服务共用一个磁盘缓存：启动后订单可以先从缓存显示，
+    // 未变化的数据只需一次条件请求（304）即可确认
+    // -------------------------------------------------------------------------
+    auto responseCache = std::make_shared<ResponseCache>();
+    m_ordersService->setResponseCache(responseCache);
+    m_demoService->setResponseCache(responseCache);
+
     // -------------------------------------------------------------------------
     // 【QML 类型注册】
     // 必须在 QML 引擎加载任何使用这些类型的文件之前完成
@@ -178,6 +200,9 @@ void OrdersPlugin::stop()
     // 在此保存数据、断开连接、释放资源
     // 服务实例会在析构函数中自动销毁（unique_ptr）
     // -------------------------------------------------------------------------
+    if (m_refreshScheduler) {
+        m_refreshScheduler->flush();  // 让徽章等派生状态反映停止前的最终数据
+    }
 }
 
 // =============================================================================
@@ -282,12 +307,16 @@ void OrdersPlugin::registerRoutes()
         
         // ---------------------------------------------------------------------
         // 【信号连接】
-        // 当数据变化时自动更新徽章
-        // 这是 Qt 信号槽机制的典型应用
+        // 当数据变化时更新徽章
+        // 变化只是请求刷新，实际的 setBadge 由调度器合并、限频后执行，
+        // 执行时读取的是当时最新的订单数
         // ---------------------------------------------------------------------
-        connect(m_ordersService.get(), &OrdersService::ordersChanged, this, [this, menu]() {
+        m_refreshScheduler->addTask("orders.badge", [this, menu]() {
             menu->setBadge("orders", QString::number(m_ordersService->getOrderCount()));
         });
+        connect(m_ordersService.get(), &OrdersService::ordersChanged, this, [this]() {
+            m_refreshScheduler->request("orders.badge");
+        });
         
         MPF_LOG_DEBUG("OrdersPlugin", "Registered menu item");
 
@@ -339,8 +368,12 @@ void OrdersPlugin::registerQmlTypes()
     // 
     // QML 中使用: import YourCo.Orders 1.0
     //            OrderModel { service: OrdersService }
+    //            SortedOrderModel { service: OrdersService; sortKeys: ["-total"] }
+    //            GroupSummaryModel { service: OrdersService; groupBy: "customerName" }
     // -------------------------------------------------------------------------
     qmlRegisterType<OrderModel>("YourCo.Orders", 1, 0, "OrderModel");
+    qmlRegisterType<SortedOrderModel>("YourCo.Orders", 1, 0, "SortedOrderModel");
+    qmlRegisterType<GroupSummaryModel>("YourCo.Orders", 1, 0, "GroupSummaryModel");
 
     // Register DemoService singleton for QML
     qmlRegisterSingletonInstance("YourCo.Orders", 1, 0, "DemoService", m_demoService.get());
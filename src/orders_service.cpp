@@ -17,6 +17,10 @@
  */
 
 #include "orders_service.h"
+#include "order_query.h"
+#include "order_ingest.h"
+#include "response_cache.h"
+#include "order_wire.h"
 
 // -----------------------------------------------------------------------------
 // 【MPF HTTP 客户端】
@@ -25,16 +29,36 @@
 // -----------------------------------------------------------------------------
 #include <mpf/http/http_client.h>
 
-#include <QUuid>
+#include <QRandomGenerator>
 #include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QMap>
 #include <QNetworkReply>
-#include <algorithm>
+#include <QPointer>
+#include <QThread>
+#include <QUrlQuery>
+#include <limits>
 
 namespace orders {
 
+/**
+ * @brief 分页载入的进度（fetchAllOrdersPaged）
+ */
+struct OrdersService::PagedFetch
+{
+    QString url;
+    int pageSize = 0;
+    int maxInFlight = 0;
+    int pageCount = 1;     // 第一页到达前只请求第一页；-1 表示页数未知
+    int nextPage = 0;      // 下一个要请求的页
+    int nextToApply = 0;   // 下一个要写入存储的页
+    int inFlight = 0;
+    QMap<int, QList<Order>> arrived;  // 已到达、等待前面页的页
+    QMap<int, QString> failed;        // 页数未知时失败的页：可能只是越界，轮到它写入时才算失败
+};
+
 // =============================================================================
 // 数据结构方法实现
 // =============================================================================
@@ -60,11 +84,11 @@ QVariantMap Order::toVariantMap() const
         {"customerName", customerName},
         {"productName", productName},
         {"quantity", quantity},
-        {"price", price},
+        {"price", money::toMajor(priceMinor)},
         {"status", status},
         {"createdAt", createdAt},
         {"updatedAt", updatedAt},
-        {"total", quantity * price}  // 计算属性，方便 QML 直接使用
+        {"total", money::toMajor(totalMinor())}  // 计算属性，方便 QML 直接使用
     };
 }
 
@@ -84,7 +108,7 @@ Order Order::fromVariantMap(const QVariantMap& map)
     order.customerName = map.value("customerName").toString();
     order.productName = map.value("productName").toString();
     order.quantity = map.value("quantity").toInt();
-    order.price = map.value("price").toDouble();
+    order.priceMinor = money::fromMajor(map.value("price").toDouble());  // 转为定点金额
     order.status = map.value("status", "pending").toString();  // 默认值
     order.createdAt = map.value("createdAt").toDateTime();
     order.updatedAt = map.value("updatedAt").toDateTime();
@@ -104,9 +128,51 @@ OrdersService::OrdersService(QObject* parent)
     // -------------------------------------------------------------------------
     , m_httpClient(std::make_unique<mpf::http::HttpClient>(this))
 {
+    setIdGenerator(nullptr);  // 默认 Snowflake 生成器
+
+    // 统计值由存储实时维护，任何数据变化后通知统计属性刷新
+    // （设置了刷新调度器时合并、限频后再通知）
+    connect(this, &OrdersService::ordersChanged, this, [this]() {
+        if (m_refreshScheduler) {
+            m_refreshScheduler->request(kStatsRefreshTask);
+        } else {
+            emit statsChanged();
+        }
+    });
+}
+
+OrdersService::~OrdersService()
+{
+    if (m_refreshScheduler) {
+        m_refreshScheduler->removeTask(kStatsRefreshTask);
+    }
+    if (m_ingestThread) {
+        m_ingestThread->quit();
+        m_ingestThread->wait();
+        delete m_ingestWorker;  // 线程已停止，可以直接删除
+    }
+}
+
+void OrdersService::setRefreshScheduler(RefreshScheduler* scheduler)
+{
+    if (m_refreshScheduler) {
+        m_refreshScheduler->removeTask(kStatsRefreshTask);
+    }
+    m_refreshScheduler = scheduler;
+    if (m_refreshScheduler) {
+        m_refreshScheduler->addTask(kStatsRefreshTask, [this]() { emit statsChanged(); });
+    }
+}
+
+void OrdersService::setResponseCache(std::shared_ptr<ResponseCache> cache)
+{
+    m_responseCache = std::move(cache);
 }
 
-OrdersService::~OrdersService() = default;
+void OrdersService::setPreferCbor(bool prefer)
+{
+    m_preferCbor = prefer;
+}
 
 // =============================================================================
 // CRUD 操作实现
@@ -116,14 +182,15 @@ OrdersService::~OrdersService() = default;
  * @brief 获取所有数据
  * 
  * 【实现模式】
- * 遍历内部数据列表，转换为 QVariantList 返回给 QML
+ * 按插入顺序遍历存储中的存活订单，转换为 QVariantList 返回给 QML
  */
 QVariantList OrdersService::getAllOrders() const
 {
     QVariantList result;
-    for (const Order& order : m_orders) {
+    result.reserve(m_store.size());
+    m_store.forEach([&result](OrderStore::Handle, const OrderView& order) {
         result.append(order.toVariantMap());
-    }
+    });
     return result;
 }
 
@@ -131,16 +198,14 @@ QVariantList OrdersService::getAllOrders() const
  * @brief 根据 ID 获取单条数据
  * 
  * 【实现模式】
- * 使用 std::find_if 查找，比循环更简洁
+ * 通过 OrderStore 的主键索引查找，O(1)
  * 找不到时返回空 QVariantMap，QML 中可以用 Object.keys(result).length === 0 判断
  */
 QVariantMap OrdersService::getOrder(const QString& id) const
 {
-    auto it = std::find_if(m_orders.begin(), m_orders.end(),
-        [&id](const Order& o) { return o.id == id; });
-    
-    if (it != m_orders.end()) {
-        return it->toVariantMap();
+    const OrderStore::Handle handle = m_store.find(id);
+    if (handle != OrderStore::InvalidHandle) {
+        return m_store.at(handle).toVariantMap();
     }
     return {};  // 返回空 map 表示未找到
 }
@@ -162,7 +227,9 @@ QVariantMap OrdersService::getOrder(const QString& id) const
 QString OrdersService::createOrder(const QVariantMap& data)
 {
     Order order = Order::fromVariantMap(data);
-    order.id = generateId();                        // 生成唯一 ID
+    do {
+        order.id = generateId();                    // 生成唯一 ID（跳过已占用的 ID）
+    } while (m_store.contains(order.id));
     order.createdAt = QDateTime::currentDateTime(); // 设置创建时间
     order.updatedAt = order.createdAt;              // 更新时间同创建时间
     
@@ -171,11 +238,18 @@ QString OrdersService::createOrder(const QVariantMap& data)
         order.status = "pending";
     }
     
-    m_orders.append(order);
+    const OrderStore::Handle handle = m_store.insert(order);
     
-    // 发射信号通知 QML
-    emit orderCreated(order.id);
-    emit ordersChanged();
+    const OrderEvent event = OrderEvent::created(++m_eventSequence, order);
+    m_changes.inserted(handle, order.id);
+    m_changes.addEvent(event);
+    
+    // 发射信号通知 QML（批处理期间只累积变更，由 endBatch() 统一发出）
+    if (!inBatch()) {
+        commitChanges();
+        emit orderCreated(order.id);
+        emit orderEvent(event);
+    }
     
     return order.id;
 }
@@ -189,24 +263,32 @@ QString OrdersService::createOrder(const QVariantMap& data)
  */
 bool OrdersService::updateOrder(const QString& id, const QVariantMap& data)
 {
-    auto it = std::find_if(m_orders.begin(), m_orders.end(),
-        [&id](const Order& o) { return o.id == id; });
-    
-    if (it == m_orders.end()) {
+    const OrderStore::Handle handle = m_store.find(id);
+    if (handle == OrderStore::InvalidHandle) {
         return false;  // 未找到
     }
     
     // 部分更新：只更新传入的字段
-    if (data.contains("customerName")) it->customerName = data["customerName"].toString();
-    if (data.contains("productName")) it->productName = data["productName"].toString();
-    if (data.contains("quantity")) it->quantity = data["quantity"].toInt();
-    if (data.contains("price")) it->price = data["price"].toDouble();
-    if (data.contains("status")) it->status = data["status"].toString();
+    const Order before = m_store.at(handle).toOrder();
+    Order order = before;
+    if (data.contains("customerName")) order.customerName = data["customerName"].toString();
+    if (data.contains("productName")) order.productName = data["productName"].toString();
+    if (data.contains("quantity")) order.quantity = data["quantity"].toInt();
+    if (data.contains("price")) order.priceMinor = money::fromMajor(data["price"].toDouble());
+    if (data.contains("status")) order.status = data["status"].toString();
     
-    it->updatedAt = QDateTime::currentDateTime();  // 更新时间戳
+    order.updatedAt = QDateTime::currentDateTime();  // 更新时间戳
+    m_store.update(handle, order);                   // 同步维护状态索引
     
-    emit orderUpdated(id);
-    emit ordersChanged();
+    const OrderEvent event = OrderEvent::updated(++m_eventSequence, before, order);
+    m_changes.updated(handle, id, OrderChange::diff(before, order));
+    m_changes.addEvent(event);
+    
+    if (!inBatch()) {
+        commitChanges();
+        emit orderUpdated(id);
+        emit orderEvent(event);
+    }
     
     return true;
 }
@@ -215,21 +297,28 @@ bool OrdersService::updateOrder(const QString& id, const QVariantMap& data)
  * @brief 删除数据
  * 
  * 【实现模式】
- * 使用 erase() 从容器中移除元素
+ * 墓碑删除：只标记槽位无效，不移动其他元素
+ * 墓碑累积过多时压缩一次存储
  */
 bool OrdersService::deleteOrder(const QString& id)
 {
-    auto it = std::find_if(m_orders.begin(), m_orders.end(),
-        [&id](const Order& o) { return o.id == id; });
-    
-    if (it == m_orders.end()) {
+    const OrderStore::Handle handle = m_store.find(id);
+    if (handle == OrderStore::InvalidHandle) {
         return false;
     }
     
-    m_orders.erase(it);
+    const Order removed = m_store.at(handle).toOrder();  // 删除前的完整内容，随事件发出
+    m_store.remove(handle);
+    const OrderEvent event = OrderEvent::deleted(++m_eventSequence, removed);
+    m_changes.removed(handle, id);
+    m_changes.addEvent(event);
     
-    emit orderDeleted(id);
-    emit ordersChanged();
+    // 墓碑过多时由 commitChanges() 压缩（批处理期间推迟到 endBatch()）
+    if (!inBatch()) {
+        commitChanges();
+        emit orderDeleted(id);
+        emit orderEvent(event);
+    }
     
     return true;
 }
@@ -250,18 +339,106 @@ bool OrdersService::updateStatus(const QString& id, const QString& status)
     return updateOrder(id, {{"status", status}});
 }
 
+// =============================================================================
+// 批量操作实现
+// =============================================================================
+
 /**
- * @brief 按条件筛选数据
+ * @brief 批量创建
+ * 
+ * 【实现模式】
+ * 在一个批处理作用域内逐条调用 createOrder，
+ * 所有变更在 endBatch() 时合并为一个变更集发出
  */
-QVariantList OrdersService::getOrdersByStatus(const QString& status) const
+QStringList OrdersService::createOrders(const QVariantList& list)
 {
-    QVariantList result;
-    for (const Order& order : m_orders) {
-        if (order.status == status) {
-            result.append(order.toVariantMap());
+    QStringList ids;
+    ids.reserve(list.size());
+    
+    beginBatch();
+    m_store.reserve(m_store.slotCount() + static_cast<int>(list.size()));
+    for (const QVariant& item : list) {
+        ids.append(createOrder(item.toMap()));
+    }
+    endBatch();
+    
+    return ids;
+}
+
+int OrdersService::updateOrders(const QVariantMap& updates)
+{
+    int updated = 0;
+    
+    beginBatch();
+    for (auto it = updates.constBegin(); it != updates.constEnd(); ++it) {
+        if (updateOrder(it.key(), it.value().toMap())) {
+            ++updated;
         }
     }
-    return result;
+    endBatch();
+    
+    return updated;
+}
+
+int OrdersService::deleteOrders(const QStringList& ids)
+{
+    int deleted = 0;
+    
+    beginBatch();
+    for (const QString& id : ids) {
+        if (deleteOrder(id)) {
+            ++deleted;
+        }
+    }
+    endBatch();
+    
+    return deleted;
+}
+
+void OrdersService::beginBatch()
+{
+    ++m_batchDepth;
+}
+
+void OrdersService::endBatch()
+{
+    if (m_batchDepth == 0) {
+        return;  // 不匹配的 endBatch()
+    }
+    if (--m_batchDepth == 0) {
+        commitChanges();
+    }
+}
+
+/**
+ * @brief 发出累积的变更
+ * 
+ * 需要时先压缩存储：压缩放在所有变更之后，
+ * 保证变更集中的 Handle 都是压缩前的值（见 order_change_set.h）
+ */
+OrderChangeSet OrdersService::commitChanges()
+{
+    if (m_store.needsCompaction()) {
+        m_changes.setRemap(m_store.compact());  // 持有 Handle 的监听方据此重映射
+    }
+    if (m_changes.isEmpty()) {
+        return {};
+    }
+    
+    const OrderChangeSet changes = m_changes.take();
+    emit orderChanges(changes);
+    emit ordersChanged();
+    return changes;
+}
+
+/**
+ * @brief 按条件筛选数据
+ * 
+ * 直接读取存储的状态索引，只访问匹配的订单
+ */
+QVariantList OrdersService::getOrdersByStatus(const QString& status) const
+{
+    return toVariantList(m_store.handlesWithStatus(status));
 }
 
 /**
@@ -269,29 +446,130 @@ QVariantList OrdersService::getOrdersByStatus(const QString& status) const
  */
 int OrdersService::getOrderCount() const
 {
-    return m_orders.size();
+    return m_store.aggregates().count();
 }
 
 /**
- * @brief 计算统计数据（总收入）
+ * @brief 读取统计数据（总收入）
+ * 
+ * 总收入由 OrderAggregates 以定点金额增量维护，这里是 O(1) 读取
  */
 double OrdersService::getTotalRevenue() const
 {
-    double total = 0;
-    for (const Order& order : m_orders) {
-        total += order.quantity * order.price;
+    return money::toMajor(m_store.aggregates().revenue());
+}
+
+/**
+ * @brief 读取各状态统计
+ */
+QVariantMap OrdersService::statusSummary() const
+{
+    return m_store.aggregates().statusSummary(m_store.strings());
+}
+
+/**
+ * @brief 收入分布统计
+ * 
+ * 使用列式聚合内核（SIMD）扫描金额列，单次扫描得到总和与最小/最大订单金额
+ */
+QVariantMap OrdersService::getRevenueStats(const QString& status) const
+{
+    const OrderStore::RevenueStats stats = status.isEmpty()
+        ? m_store.revenueStats()
+        : m_store.revenueStats(status);
+
+    return {
+        {"count", stats.count},
+        {"sum", money::toMajor(stats.sumMinor)},
+        {"min", money::toMajor(stats.minMinor)},
+        {"max", money::toMajor(stats.maxMinor)},
+        {"average", stats.count > 0 ? money::toMajor(stats.sumMinor) / stats.count : 0.0}
+    };
+}
+
+// =============================================================================
+// 时间范围查询
+// =============================================================================
+
+namespace {
+
+// 无效的起止时间表示区间在该方向上不限
+qint64 rangeStartMs(const QDateTime& from)
+{
+    return from.isValid() ? from.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min() + 1;
+}
+
+qint64 rangeEndMs(const QDateTime& to)
+{
+    return to.isValid() ? to.toMSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+}
+
+} // namespace
+
+QVariantList OrdersService::getOrdersCreatedBetween(const QDateTime& from, const QDateTime& to) const
+{
+    return toVariantList(m_store.handlesCreatedBetween(rangeStartMs(from), rangeEndMs(to)));
+}
+
+QVariantList OrdersService::getOrdersUpdatedBetween(const QDateTime& from, const QDateTime& to) const
+{
+    return toVariantList(m_store.handlesUpdatedBetween(rangeStartMs(from), rangeEndMs(to)));
+}
+
+QVariantList OrdersService::getOrdersUpdatedSince(const QDateTime& since) const
+{
+    return getOrdersUpdatedBetween(since, QDateTime());
+}
+
+QVariantList OrdersService::search(const QString& query, int limit) const
+{
+    return toVariantList(m_store.search(query, limit));
+}
+
+QVariantMap OrdersService::queryOrders(const QVariantMap& query) const
+{
+    const OrderQuery q = OrderQuery::fromVariantMap(query);
+    const OrderQueryResult result = m_store.query(q);
+    return {
+        {"orders", toVariantList(result.handles)},
+        {"total", result.total},
+        {"offset", q.offset},
+        {"limit", q.limit}
+    };
+}
+
+QVariantList OrdersService::toVariantList(const std::vector<OrderStore::Handle>& handles) const
+{
+    QVariantList result;
+    result.reserve(static_cast<qsizetype>(handles.size()));
+    for (OrderStore::Handle handle : handles) {
+        result.append(m_store.at(handle).toVariantMap());
     }
-    return total;
+    return result;
 }
 
 /**
  * @brief 生成唯一 ID
  * 
- * 使用 Qt 的 UUID 生成器，取前 8 位作为简短 ID
+ * 委托给可替换的 OrderIdGenerator，默认为 Snowflake 风格的 64 位单调 ID
  */
 QString OrdersService::generateId() const
 {
-    return QUuid::createUuid().toString(QUuid::WithoutBraces).left(8);
+    return m_idGenerator->next();
+}
+
+/**
+ * @brief 替换 ID 生成器
+ * 
+ * 默认节点号随机选取，降低多个插件实例同时生成时的冲突概率
+ */
+void OrdersService::setIdGenerator(std::unique_ptr<OrderIdGenerator> generator)
+{
+    if (!generator) {
+        const quint32 node = QRandomGenerator::global()->bounded(SnowflakeIdGenerator::kMaxNodeId + 1);
+        generator = std::make_unique<SnowflakeIdGenerator>(node);
+    }
+    m_idGenerator = std::move(generator);
 }
 
 // =============================================================================
@@ -299,6 +577,15 @@ QString OrdersService::generateId() const
 // 【MPF HTTP 客户端使用示例】
 // =============================================================================
 
+namespace {
+
+OrderIngestWorker::Format ingestFormat(const QByteArray& contentType)
+{
+    return wire::isCbor(contentType) ? OrderIngestWorker::Format::Cbor : OrderIngestWorker::Format::Json;
+}
+
+} // namespace
+
 /**
  * @brief 从服务器获取数据
  * 
@@ -347,49 +634,731 @@ void OrdersService::fetchOrdersFromServer(const QString& apiUrl)
     
     // -------------------------------------------------------------------------
     // 步骤2: 发送 GET 请求
+    // 相同地址的抓取进行中时直接共享它的结果（fetchCompleted 只发出一次）；
+    // 否则取代尚未完成的旧抓取：旧请求被中止，其回调与批次按编号忽略
     // -------------------------------------------------------------------------
-    QNetworkReply* reply = m_httpClient->get(QUrl(apiUrl), options);
+    if (!m_pagedFetch && m_fetchUrl == apiUrl) {
+        return;
+    }
+    const quint64 generation = startFetch(apiUrl);
+    
+    ensureIngestWorker();
+    OrderIngestWorker* worker = m_ingestWorker;
     
     // -------------------------------------------------------------------------
-    // 步骤3: 异步处理响应
-    // 使用 lambda 连接 finished 信号
+    // 【响应缓存】
+    // - 新鲜的缓存：直接载入，不请求服务器
+    // - 过期但在 stale-while-revalidate 窗口内：先载入缓存让界面立即显示，
+    //   同时发出条件请求；200 时按 ID 合并新数据，304 时什么都不用做
+    // - 其他情况：发出条件请求，304 时再载入缓存
     // -------------------------------------------------------------------------
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+    // 【传输格式】优先 CBOR，服务器只支持 JSON 时按 Content-Type 回退（见 order_wire.h）
+    // Accept 属于缓存键：切换格式后不会误用另一种格式的缓存
+    const QString accept = wire::acceptHeader(m_preferCbor);
+    options.headers["Accept"] = accept;
+    
+    const QUrl url(apiUrl);
+    ResponseCache::Entry cached;
+    if (m_responseCache) {
+        m_fetchCacheKey = ResponseCache::key(url, {{QStringLiteral("Accept"), accept}});
+        cached = m_responseCache->lookup(m_fetchCacheKey);
+    }
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (cached.isFresh(now)) {
+        ingestCached(generation, cached.body, cached.contentType);
+        return;
+    }
+    if (cached.canServeStale(now)) {
+        ingestCached(generation, cached.body, cached.contentType);
+    }
+    if (cached.isValid()) {
+        for (const auto& header : ResponseCache::conditionalHeaders(cached)) {
+            options.headers[header.first] = header.second;
+        }
+    }
+    
+    QNetworkReply* reply = m_httpClient->get(url, options);
+    m_fetchReply = reply;
+    m_fetchNetwork = true;
+    
+    // -------------------------------------------------------------------------
+    // 步骤3: 流式处理响应
+    // 每段到达的字节直接转交工作线程解析，GUI 线程不做 JSON / CBOR 解析
+    // -------------------------------------------------------------------------
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply, worker, generation]() {
+        if (generation != m_fetchGeneration || ResponseCache::isNotModified(reply)) {
+            return;
+        }
+        const QByteArray chunk = reply->readAll();
+        if (m_responseCache) {
+            m_fetchBody.append(chunk);  // 完整响应体在结束时写入缓存
+        }
+        // 网络数据排在缓存数据之后解析，第一段到达时才开始新一轮解析
+        const bool begin = !m_fetchStreamStarted;
+        m_fetchStreamStarted = true;
+        const auto format = ingestFormat(reply->rawHeader("Content-Type"));
+        QMetaObject::invokeMethod(worker, [worker, generation, chunk, begin, format]() {
+            if (begin) {
+                worker->begin(generation, format);
+            }
+            worker->feed(generation, chunk);
+        });
+    });
+    
+    connect(reply, &QNetworkReply::downloadProgress, this, [this, generation](qint64 received, qint64 total) {
+        if (generation == m_fetchGeneration) {
+            m_fetchBytes = received;
+            m_fetchBytesTotal = total;
+        }
+    });
+    
+    connect(reply, &QNetworkReply::finished, this, [this, reply, worker, generation]() {
         // 重要：响应处理完后释放 reply 对象
         reply->deleteLater();
+        if (generation != m_fetchGeneration) {
+            return;  // 已被新的抓取取代
+        }
+        m_fetchReply = nullptr;
+        m_fetchNetwork = false;
         
-        // 检查网络错误
+        // 检查网络错误（已经或正在显示缓存数据时保留它们）
         if (reply->error() != QNetworkReply::NoError) {
-            emit fetchCompleted(false, reply->errorString());
+            if (m_fetchFromCache) {
+                return;  // 缓存载入结束时完成本次载入
+            }
+            if (m_fetchCacheServed) {
+                m_fetchUrl.clear();
+                emit fetchCompleted(false, reply->errorString());
+                return;
+            }
+            failFetch(reply->errorString());
+            return;
+        }
+        
+        // 304：缓存的响应仍然有效
+        if (ResponseCache::isNotModified(reply)) {
+            const ResponseCache::Entry entry = m_responseCache
+                ? m_responseCache->refresh(m_fetchCacheKey, reply, ResponseCache::kDefaultStaleWhileRevalidate)
+                : ResponseCache::Entry();
+            if (m_fetchFromCache) {
+                return;  // 缓存仍在载入，由它结束本次载入
+            }
+            if (m_fetchCacheServed) {
+                m_fetchUrl.clear();
+                emit fetchCompleted(true, QStringLiteral("Up to date"));
+            } else if (entry.isValid()) {
+                ingestCached(generation, entry.body, entry.contentType);
+            } else {
+                failFetch(QStringLiteral("Not modified, but no cached response"));
+            }
+            return;
+        }
+        
+        // 剩余字节与结束标记按顺序排在已转交的字节之后
+        const QByteArray rest = reply->readAll();
+        if (m_responseCache) {
+            m_fetchBody.append(rest);
+            m_fetchCacheStored = m_responseCache->store(m_fetchCacheKey, reply, m_fetchBody,
+                                                        ResponseCache::kDefaultStaleWhileRevalidate);
+            m_fetchBody.clear();
+        }
+        const bool begin = !m_fetchStreamStarted;
+        m_fetchStreamStarted = true;
+        const auto format = ingestFormat(reply->rawHeader("Content-Type"));
+        QMetaObject::invokeMethod(worker, [worker, generation, rest, begin, format]() {
+            if (begin) {
+                worker->begin(generation, format);
+            }
+            if (!rest.isEmpty()) {
+                worker->feed(generation, rest);
+            }
+            worker->finish(generation);
+        });
+    });
+}
+
+void OrdersService::ingestCached(quint64 generation, const QByteArray& body, const QByteArray& contentType)
+{
+    // 缓存的响应体同样交给工作线程解析，整段一次转交
+    m_fetchFromCache = true;
+    OrderIngestWorker* worker = m_ingestWorker;
+    const auto format = ingestFormat(contentType);
+    QMetaObject::invokeMethod(worker, [worker, generation, body, format]() {
+        worker->begin(generation, format);
+        worker->feed(generation, body);
+        worker->finish(generation);
+    });
+}
+
+void OrdersService::ensureIngestWorker()
+{
+    if (m_ingestThread) {
+        return;
+    }
+    
+    m_ingestThread = new QThread(this);
+    m_ingestThread->setObjectName(QStringLiteral("OrdersIngest"));
+    m_ingestWorker = new OrderIngestWorker();
+    m_ingestWorker->moveToThread(m_ingestThread);
+    
+    // 跨线程连接：批次与结束通知在 GUI 线程按发出顺序处理
+    connect(m_ingestWorker, &OrderIngestWorker::batchReady, this, &OrdersService::applyFetchedBatch);
+    connect(m_ingestWorker, &OrderIngestWorker::finished, this, &OrdersService::finishFetch);
+    m_ingestThread->start();
+}
+
+void OrdersService::applyFetchedBatch(quint64 generation, const QList<Order>& orders)
+{
+    if (generation != m_fetchGeneration) {
+        return;
+    }
+    
+    beginFetchApply();
+    
+    if (m_fetchMerge) {
+        // 按 ID 合并：内容未变的行直接跳过，只有变化的行进入变更集
+        for (const Order& order : orders) {
+            if (order.id.isEmpty() || m_fetchSeen.contains(order.id)) {
+                continue;  // 重复 ID 只保留第一条
+            }
+            m_fetchSeen.insert(order.id);
+            upsertOrder(order);
+            ++m_fetchLoaded;
+        }
+    } else {
+        m_store.reserve(m_store.slotCount() + static_cast<int>(orders.size()));
+        for (const Order& order : orders) {
+            const OrderStore::Handle handle = m_store.insert(order);
+            if (handle != OrderStore::InvalidHandle) {
+                m_changes.inserted(handle, order.id);
+                ++m_fetchLoaded;
+            }
+        }
+    }
+    
+    // 每批写入后立即发出：批次之间会回到事件循环，
+    // 不能让未发出的变更跨越事件循环（期间的本地编辑会把它们连同自己的事件一起提交）
+    if (!inBatch()) {
+        commitChanges();
+    }
+    emit fetchProgress(m_fetchBytes, m_fetchBytesTotal, m_fetchLoaded);
+}
+
+void OrdersService::beginFetchApply()
+{
+    if (m_fetchApplied) {
+        return;
+    }
+    
+    // 第一批到达时才决定如何写入，之前出错时原有数据保持不变：
+    // - 本地为空（冷启动）：逐批追加，每批一个变更集，监听方整体重建
+    // - 本地已有数据：按 ID 合并，每批一个只含变化行的变更集，保留未变化行的 Handle 与模型状态
+    m_fetchApplied = true;
+    m_fetchMerge = m_store.size() > 0;
+    m_fetchSeen.clear();
+    if (!m_fetchMerge) {
+        m_store.clear();  // 只剩墓碑，clear() 保留已分配的容量
+        m_changes.setReset();
+    }
+    resetSync();  // 整体载入后游标不再对应本地数据
+}
+
+quint64 OrdersService::startFetch(const QString& apiUrl)
+{
+    const quint64 generation = ++m_fetchGeneration;
+    if (m_fetchReply) {
+        m_fetchReply->abort();
+    }
+    cancelPagedFetch();
+    m_fetchUrl = apiUrl;
+    m_fetchCacheKey.clear();
+    m_fetchBody.clear();
+    m_fetchFromCache = false;
+    m_fetchCacheServed = false;
+    m_fetchCacheStored = false;
+    m_fetchNetwork = false;
+    m_fetchStreamStarted = false;
+    m_fetchApplied = false;
+    m_fetchBytes = 0;
+    m_fetchBytesTotal = -1;
+    m_fetchLoaded = 0;
+    return generation;
+}
+
+void OrdersService::cancelPagedFetch()
+{
+    if (m_pagedFetch) {
+        m_pagedFetch.reset();
+        cancelOrdersPages(this);
+    }
+}
+
+void OrdersService::failFetch(const QString& error)
+{
+    ++m_fetchGeneration;  // 丢弃仍在进行中的批次与页
+    cancelPagedFetch();
+    m_fetchUrl.clear();
+    m_fetchSeen.clear();
+    
+    // 已合并的变化保留在存储中，照常通知监听方；缺失行的删除只在完整载入后进行
+    if (!inBatch()) {
+        commitChanges();
+    }
+    emit fetchCompleted(false, error);
+}
+
+void OrdersService::finishFetch(quint64 generation, bool ok, const QString& error, int /*total*/)
+{
+    if (generation != m_fetchGeneration) {
+        return;
+    }
+    
+    const bool fromCache = m_fetchFromCache;
+    m_fetchFromCache = false;
+    
+    if (!ok) {
+        // 删除无法解析的那份缓存：网络响应体，或尚未被后台 200 覆盖的缓存。
+        // 损坏的缓存解析失败时新的响应可能已经写入，不能把它一起删掉
+        if (m_responseCache && !m_fetchCacheKey.isEmpty() && (!fromCache || !m_fetchCacheStored)) {
+            m_responseCache->remove(m_fetchCacheKey);
+        }
+        if (fromCache && m_fetchNetwork) {
+            // 缓存损坏：已合并的部分照常发出，继续等待条件请求的结果
+            if (!inBatch()) {
+                commitChanges();
+            }
+            m_fetchApplied = false;
+            m_fetchSeen.clear();
+            return;
+        }
+        failFetch(error);
+        return;
+    }
+    
+    beginFetchApply();  // 空数组：同样是一次完整载入
+    
+    // 完整载入是权威的：本次响应中没有的订单已在服务器上删除
+    beginBatch();
+    if (m_fetchMerge) {
+        QStringList missing;
+        m_store.forEach([this, &missing](OrderStore::Handle, const OrderView& order) {
+            const QString id = order.id();
+            if (!m_fetchSeen.contains(id)) {
+                missing.append(id);
+            }
+        });
+        for (const QString& id : std::as_const(missing)) {
+            deleteOrder(id);
+        }
+    }
+    endBatch();  // 缺失订单的删除作为一个变更集发出
+    m_fetchSeen.clear();
+    
+    if (fromCache && m_fetchNetwork) {
+        // 缓存数据已显示，后台的条件请求返回新数据时再按 ID 合并一次
+        m_fetchCacheServed = true;
+        m_fetchApplied = false;
+        emit fetchCompleted(true, QStringLiteral("Loaded %1 cached orders").arg(m_store.size()));
+        return;
+    }
+    
+    m_fetchUrl.clear();
+    emit fetchCompleted(true, fromCache ? QStringLiteral("Loaded %1 cached orders").arg(m_store.size())
+                                        : QStringLiteral("Fetched %1 orders").arg(m_store.size()));
+}
+
+/**
+ * @brief 分页并发的整体载入
+ * 
+ * 【实现模式】
+ * 复用 fetchOrdersPage 请求每一页，复用 applyFetchedBatch / finishFetch 写入与收尾，
+ * 与流式载入共用 m_fetchGeneration：新的载入开始后，旧载入的页全部被丢弃
+ */
+void OrdersService::fetchAllOrdersPaged(const QString& apiUrl, int pageSize, int maxInFlight)
+{
+    pageSize = qMax(1, pageSize);
+    if (m_pagedFetch && m_fetchUrl == apiUrl && m_pagedFetch->pageSize == pageSize) {
+        return;  // 相同的载入进行中，共享其结果
+    }
+    const quint64 generation = startFetch(apiUrl);
+    
+    m_pagedFetch = std::make_unique<PagedFetch>();
+    m_pagedFetch->url = apiUrl;
+    m_pagedFetch->pageSize = pageSize;
+    m_pagedFetch->maxInFlight = qMax(1, maxInFlight);
+    requestFetchPages(generation);
+}
+
+void OrdersService::requestFetchPages(quint64 generation)
+{
+    PagedFetch& fetch = *m_pagedFetch;
+    while (fetch.inFlight < fetch.maxInFlight
+           && (fetch.pageCount < 0 || fetch.nextPage < fetch.pageCount)) {
+        const int page = fetch.nextPage++;
+        ++fetch.inFlight;
+        fetchOrdersPage(fetch.url, {}, page * fetch.pageSize, fetch.pageSize, this,
+                        [this, generation, page](const OrderPage& result) {
+            onFetchPage(generation, page, result);
+        });
+    }
+}
+
+void OrdersService::onFetchPage(quint64 generation, int page, const OrderPage& result)
+{
+    if (generation != m_fetchGeneration || !m_pagedFetch) {
+        return;  // 已被取代，或是末页之后预取的页
+    }
+    
+    PagedFetch& fetch = *m_pagedFetch;
+    --fetch.inFlight;
+    
+    // 末页之后预取的页：页数已知后，其结果（包括服务器对越界 offset 返回的错误）与本次载入无关
+    if (fetch.pageCount >= 0 && page >= fetch.pageCount) {
+        return;
+    }
+    
+    if (!result.ok) {
+        if (fetch.pageCount < 0 && page != fetch.nextToApply) {
+            // 页数未知：可能是末页之后的页，等前面的页到达后再判断
+            fetch.failed.insert(page, result.error);
             return;
         }
+        failFetch(result.error);
+        return;
+    }
+    
+    // 第一页给出总数；不满一页说明服务器已没有更多数据
+    if (page == 0) {
+        fetch.pageCount = result.total >= 0 ? qMax(1, (result.total + fetch.pageSize - 1) / fetch.pageSize) : -1;
+    }
+    if (result.orders.size() < fetch.pageSize && (fetch.pageCount < 0 || page + 1 < fetch.pageCount)) {
+        fetch.pageCount = page + 1;
+    }
+    if (fetch.pageCount < 0 || page < fetch.pageCount) {
+        fetch.arrived.insert(page, result.orders);
+    }
+    
+    // 按页序写入：后面的页先到时留在 arrived 中等待。
+    // 写入会同步发出变更信号，监听方可能在其中开始新的载入并释放 m_pagedFetch，
+    // 因此先取出这一页再写入，每页之后重新检查
+    while ((fetch.pageCount < 0 || fetch.nextToApply < fetch.pageCount)
+           && fetch.arrived.contains(fetch.nextToApply)) {
+        const QList<Order> batch = fetch.arrived.take(fetch.nextToApply++);
+        applyFetchedBatch(generation, batch);
+        if (generation != m_fetchGeneration || !m_pagedFetch) {
+            return;
+        }
+    }
+    
+    if (fetch.pageCount >= 0 && fetch.nextToApply >= fetch.pageCount) {
+        cancelPagedFetch();  // 中止末页之后预取的页
+        finishFetch(generation, true, {}, m_fetchLoaded);
+        return;
+    }
+    if (fetch.failed.contains(fetch.nextToApply)) {
+        failFetch(fetch.failed.value(fetch.nextToApply));  // 前面的页都是满页，这一页确实在范围内
+        return;
+    }
+    requestFetchPages(generation);
+}
+
+/**
+ * @brief 增量同步
+ * 
+ * 【实现模式】
+ * 与 fetchOrdersFromServer 相同的请求流程，额外携带游标与 ETag；
+ * 响应只包含变化，直接在 GUI 线程解析并应用
+ */
+void OrdersService::syncOrders(const QString& apiUrl)
+{
+    if (apiUrl != m_syncUrl) {
+        if (m_syncReply) {
+            // abort() 同步发出 finished：先清空 m_syncReply，处理函数按"已取代"返回，
+            // 不会为被取代的同步发出 syncCompleted(false, ...)
+            QNetworkReply* superseded = m_syncReply;
+            m_syncReply = nullptr;
+            superseded->abort();
+        }
+        resetSync();
+        m_syncUrl = apiUrl;
+    } else if (m_syncReply) {
+        return;  // 同一地址的同步进行中，结果很快就会到达
+    }
+    
+    QUrl url(apiUrl);
+    if (!m_syncCursor.isEmpty()) {
+        QUrlQuery query(url);
+        query.addQueryItem(QStringLiteral("since"), m_syncCursor);
+        url.setQuery(query);
+    }
+    
+    mpf::http::HttpClient::RequestOptions options;
+    options.timeoutMs = 10000;
+    if (!m_syncEtag.isEmpty()) {
+        options.headers["If-None-Match"] = m_syncEtag;
+    }
+    
+    QNetworkReply* reply = m_httpClient->get(url, options);
+    m_syncReply = reply;
+    
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (reply != m_syncReply) {
+            return;  // 已被其他地址的同步取代
+        }
+        m_syncReply = nullptr;
         
-        // 读取响应数据
-        QByteArray data = reply->readAll();
+        if (reply->error() != QNetworkReply::NoError) {
+            emit syncCompleted(false, 0, 0, reply->errorString());
+            return;
+        }
         
-        // 解析 JSON
-        QJsonDocument doc = QJsonDocument::fromJson(data);
+        // 304：自上次同步以来没有变化
+        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+            emit syncCompleted(true, 0, 0, QStringLiteral("Up to date"));
+            return;
+        }
         
-        // 验证响应格式（期望是数组）
-        if (!doc.isArray()) {
-            emit fetchCompleted(false, QStringLiteral("Invalid JSON response"));
+        int upserted = 0;
+        int removed = 0;
+        if (!applySyncResponse(reply->readAll(), &upserted, &removed)) {
+            // 不记住 ETag：否则下次同步得到 304，这段变化永远不会被应用
+            emit syncCompleted(false, 0, 0, QStringLiteral("Invalid JSON response"));
             return;
         }
         
-        // 清空现有数据并加载新数据
-        m_orders.clear();
-        QJsonArray array = doc.array();
-        for (const QJsonValue& value : array) {
-            if (value.isObject()) {
-                QVariantMap map = value.toObject().toVariantMap();
-                m_orders.append(Order::fromVariantMap(map));
+        // 先更新验证器再通知：响应 syncCompleted 时立即再次同步的监听方带上新的 ETag
+        const QByteArray etag = reply->rawHeader("ETag");
+        if (!etag.isEmpty()) {
+            m_syncEtag = QString::fromLatin1(etag);
+        }
+        emit syncCompleted(true, upserted, removed,
+                           QStringLiteral("Synced %1 changed, %2 deleted").arg(upserted).arg(removed));
+    });
+}
+
+void OrdersService::resetSync()
+{
+    m_syncCursor.clear();
+    m_syncEtag.clear();
+}
+
+bool OrdersService::applySyncResponse(const QByteArray& body, int* upserted, int* removed)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(body);
+    QJsonArray orders;
+    QJsonArray deleted;
+    QString cursor;
+    if (doc.isArray()) {
+        orders = doc.array();
+    } else if (doc.isObject()) {
+        const QJsonObject object = doc.object();
+        orders = object.value(QStringLiteral("orders")).toArray();
+        deleted = object.value(QStringLiteral("deleted")).toArray();
+        cursor = object.value(QStringLiteral("cursor")).toString();
+    } else {
+        return false;
+    }
+    
+    // 所有变化合并为一个变更集
+    *upserted = 0;
+    *removed = 0;
+    QDateTime watermark = QDateTime::fromString(m_syncCursor, Qt::ISODateWithMs);
+    
+    beginBatch();
+    for (const QJsonValue& value : std::as_const(orders)) {
+        if (!value.isObject()) {
+            continue;
+        }
+        const Order order = Order::fromJson(value.toObject());
+        if (order.id.isEmpty()) {
+            continue;
+        }
+        if (upsertOrder(order)) {
+            ++*upserted;
+        }
+        if (order.updatedAt.isValid() && (!watermark.isValid() || order.updatedAt > watermark)) {
+            watermark = order.updatedAt;
+        }
+    }
+    for (const QJsonValue& value : std::as_const(deleted)) {
+        if (deleteOrder(value.toString())) {
+            ++*removed;
+        }
+    }
+    endBatch();
+    
+    // 服务器给出的游标优先，否则以最大 updatedAt 作为水位
+    if (!cursor.isEmpty()) {
+        m_syncCursor = cursor;
+    } else if (watermark.isValid()) {
+        m_syncCursor = watermark.toString(Qt::ISODateWithMs);
+    }
+    return true;
+}
+
+bool OrdersService::upsertOrder(const Order& order)
+{
+    const OrderStore::Handle handle = m_store.find(order.id);
+    if (handle == OrderStore::InvalidHandle) {
+        const OrderStore::Handle inserted = m_store.insert(order);
+        m_changes.inserted(inserted, order.id);
+        m_changes.addEvent(OrderEvent::created(++m_eventSequence, order));
+        return true;
+    }
+    
+    // 先比较内容哈希：未变化的行（绝大多数）不必读出整行逐字段比较
+    if (m_store.contentHashAt(handle) == OrderStore::contentHash(order)) {
+        return false;  // 内容相同（例如 since 边界上重复收到的订单）
+    }
+    
+    const Order before = m_store.at(handle).toOrder();
+    const OrderFields fields = OrderChange::diff(before, order);
+    if (!fields) {
+        return false;
+    }
+    
+    m_store.update(handle, order);
+    m_changes.updated(handle, order.id, fields);
+    m_changes.addEvent(OrderEvent::updated(++m_eventSequence, before, order));
+    return true;
+}
+
+/**
+ * @brief 获取一页订单
+ * 
+ * 【实现模式】
+ * 与 fetchOrdersFromServer 相同的请求/响应处理流程，
+ * 区别是结果交给回调而不是写入 m_store：分页模式下本地只缓存视口附近的页
+ */
+void OrdersService::fetchOrdersPage(const QString& apiUrl, const QVariantMap& params, int offset, int limit,
+                                    QObject* context, PageCallback callback)
+{
+    QUrl url(apiUrl);
+    QUrlQuery query(url);
+    query.addQueryItem(QStringLiteral("offset"), QString::number(offset));
+    query.addQueryItem(QStringLiteral("limit"), QString::number(limit));
+    for (auto it = params.constBegin(); it != params.constEnd(); ++it) {
+        if (!it.value().toString().isEmpty()) {
+            query.addQueryItem(it.key(), it.value().toString());
+        }
+    }
+    url.setQuery(query);
+
+    // 相同 URL 的请求进行中：只登记回调，共享同一个 reply
+    const QString key = url.toString(QUrl::FullyEncoded);
+    auto pending = m_pageRequests.find(key);
+    if (pending != m_pageRequests.end()) {
+        pending->waiters.append({context, std::move(callback)});
+        return;
+    }
+
+    // 新鲜的缓存页直接使用；仍然异步回调，与网络请求的时序一致
+    ResponseCache::Entry cached;
+    const QByteArray cacheKey = ResponseCache::key(url);
+    if (m_responseCache) {
+        cached = m_responseCache->lookup(cacheKey);
+    }
+    if (cached.isFresh(QDateTime::currentDateTimeUtc())) {
+        QMetaObject::invokeMethod(this, [guard = QPointer<QObject>(context), callback = std::move(callback),
+                                         body = cached.body]() {
+            if (guard) {
+                callback(parseOrdersPage(body));
+            }
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    mpf::http::HttpClient::RequestOptions options;
+    options.timeoutMs = 10000;
+    for (const auto& header : ResponseCache::conditionalHeaders(cached)) {
+        options.headers[header.first] = header.second;
+    }
+    QNetworkReply* reply = m_httpClient->get(url, options);
+    m_pageRequests.insert(key, {reply, {{context, std::move(callback)}}});
+
+    // reply 总是由服务释放；context 已销毁时丢弃结果，不再回调
+    connect(reply, &QNetworkReply::finished, this, [this, reply, key, cacheKey]() {
+        reply->deleteLater();
+        auto it = m_pageRequests.find(key);
+        if (it == m_pageRequests.end() || it->reply != reply) {
+            return;  // 已被 cancelOrdersPages 取消
+        }
+        const QList<PageWaiter> waiters = std::move(it->waiters);
+        m_pageRequests.erase(it);
+
+        OrderPage page;
+        if (reply->error() != QNetworkReply::NoError) {
+            page.error = reply->errorString();
+        } else if (ResponseCache::isNotModified(reply)) {
+            // 304：沿用缓存的页
+            const ResponseCache::Entry entry = m_responseCache
+                ? m_responseCache->refresh(cacheKey, reply, ResponseCache::kDefaultStaleWhileRevalidate)
+                : ResponseCache::Entry();
+            if (entry.isValid()) {
+                page = parseOrdersPage(entry.body);
+            } else {
+                page.error = QStringLiteral("Not modified, but no cached response");
+            }
+        } else {
+            const QByteArray body = reply->readAll();
+            page = parseOrdersPage(body);
+            if (page.ok && m_responseCache) {
+                m_responseCache->store(cacheKey, reply, body, ResponseCache::kDefaultStaleWhileRevalidate);
+            }
+        }
+
+        for (const PageWaiter& waiter : waiters) {
+            if (waiter.context) {
+                waiter.callback(page);
             }
         }
-        
-        // 通知数据已更新
-        emit ordersChanged();
-        emit fetchCompleted(true, QStringLiteral("Fetched %1 orders").arg(m_orders.size()));
     });
 }
 
+void OrdersService::cancelOrdersPages(QObject* context)
+{
+    for (auto it = m_pageRequests.begin(); it != m_pageRequests.end();) {
+        it->waiters.removeIf([context](const PageWaiter& waiter) {
+            return !waiter.context || waiter.context == context;
+        });
+        if (!it->waiters.isEmpty()) {
+            ++it;
+            continue;
+        }
+        // 没有等待方了：先移出登记表再中止，finished 回调据此直接返回
+        QPointer<QNetworkReply> reply = it->reply;
+        it = m_pageRequests.erase(it);
+        if (reply) {
+            reply->abort();
+        }
+    }
+}
+
+OrderPage OrdersService::parseOrdersPage(const QByteArray& body)
+{
+    OrderPage page;
+    const QJsonDocument doc = QJsonDocument::fromJson(body);
+    QJsonArray array;
+    if (doc.isArray()) {
+        array = doc.array();
+    } else if (doc.isObject()) {
+        const QJsonObject object = doc.object();
+        array = object.value(QStringLiteral("orders")).toArray();
+        page.total = object.value(QStringLiteral("total")).toInt(-1);
+    } else {
+        page.error = QStringLiteral("Invalid JSON response");
+        return page;
+    }
+
+    page.orders.reserve(array.size());
+    for (const QJsonValue& value : std::as_const(array)) {
+        if (value.isObject()) {
+            page.orders.append(Order::fromJson(value.toObject()));
+        }
+    }
+    page.ok = true;
+    return page;
+}
+
 } // namespace orders
@@ -0,0 +1,84 @@
+#include "refresh_scheduler.h"
+
+#include <QStringList>
+
+namespace orders {
+
+RefreshScheduler::RefreshScheduler(int maxHz, QObject* parent)
+    : QObject(parent)
+    , m_maxHz(maxHz)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &RefreshScheduler::runPending);
+}
+
+RefreshScheduler::~RefreshScheduler() = default;
+
+void RefreshScheduler::setMaxHz(int hz)
+{
+    m_maxHz = hz;
+}
+
+void RefreshScheduler::addTask(const QString& key, std::function<void()> task)
+{
+    m_tasks.insert(key, Task{std::move(task), false});
+}
+
+void RefreshScheduler::removeTask(const QString& key)
+{
+    m_tasks.remove(key);
+}
+
+void RefreshScheduler::request(const QString& key)
+{
+    auto it = m_tasks.find(key);
+    if (it == m_tasks.end()) {
+        return;
+    }
+    it->pending = true;
+    schedule();
+}
+
+void RefreshScheduler::flush()
+{
+    m_timer.stop();
+    runPending();
+}
+
+void RefreshScheduler::schedule()
+{
+    if (m_timer.isActive()) {
+        return;  // 已有一次执行在排队，本次请求随它一起执行
+    }
+
+    int delay = 0;
+    if (m_maxHz > 0 && m_sinceLastRun.isValid()) {
+        const qint64 interval = 1000 / m_maxHz;
+        delay = static_cast<int>(qMax<qint64>(0, interval - m_sinceLastRun.elapsed()));
+    }
+    m_timer.start(delay);
+}
+
+void RefreshScheduler::runPending()
+{
+    m_sinceLastRun.start();
+
+    // 先取出待执行的键：任务执行时可能再次 request 或增删任务
+    QStringList due;
+    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+        if (it->pending) {
+            it->pending = false;
+            due.append(it.key());
+        }
+    }
+
+    for (const QString& key : due) {
+        auto it = m_tasks.constFind(key);
+        if (it != m_tasks.constEnd() && it->run) {
+            const std::function<void()> run = it->run;  // 任务可能在执行中移除自身
+            run();
+        }
+    }
+}
+
+} // namespace orders
@@ -0,0 +1,254 @@
+#include "response_cache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace orders {
+
+namespace {
+
+constexpr quint32 kMagic = 0x4f524331;  // "ORC1"
+constexpr quint16 kVersion = 1;
+const QString kSuffix = QStringLiteral(".cache");
+
+QDateTime parseHttpDate(const QByteArray& value)
+{
+    // RFC 7231 的 IMF-fixdate（Sun, 06 Nov 1994 08:49:37 GMT）是 RFC 2822 的子集
+    return QDateTime::fromString(QString::fromLatin1(value).trimmed(), Qt::RFC2822Date);
+}
+
+} // namespace
+
+// =============================================================================
+// Entry
+// =============================================================================
+
+bool ResponseCache::Entry::isFresh(const QDateTime& now) const
+{
+    return isValid() && !noCache && storedAt.secsTo(now) < maxAge;
+}
+
+bool ResponseCache::Entry::canServeStale(const QDateTime& now) const
+{
+    return isValid() && !noCache && storedAt.secsTo(now) < maxAge + staleWhileRevalidate;
+}
+
+// =============================================================================
+// ResponseCache
+// =============================================================================
+
+ResponseCache::ResponseCache(const QString& directory, qint64 maxBytes)
+    : m_directory(directory)
+    , m_maxBytes(maxBytes)
+{
+    QDir().mkpath(m_directory);
+}
+
+QString ResponseCache::defaultDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/orders-http");
+}
+
+QByteArray ResponseCache::key(const QUrl& url, const QMap<QString, QString>& headers)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(url.toEncoded());
+    // QMap 按名称有序，同一组请求头总是得到同一个键
+    for (auto it = headers.constBegin(); it != headers.constEnd(); ++it) {
+        hash.addData("\n");
+        hash.addData(it.key().toLower().toUtf8());
+        hash.addData(":");
+        hash.addData(it.value().toUtf8());
+    }
+    return hash.result().toHex();
+}
+
+ResponseCache::Entry ResponseCache::lookup(const QByteArray& key) const
+{
+    QFile file(pathFor(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion) {
+        return {};
+    }
+
+    Entry entry;
+    in >> entry.status >> entry.contentType >> entry.etag >> entry.lastModified >> entry.storedAt
+       >> entry.maxAge >> entry.staleWhileRevalidate >> entry.noCache >> entry.body;
+    if (in.status() != QDataStream::Ok) {
+        return {};  // 截断或损坏的条目按未命中处理
+    }
+    return entry;
+}
+
+bool ResponseCache::store(const QByteArray& key, QNetworkReply* reply, const QByteArray& body,
+                          qint64 defaultStaleWhileRevalidate)
+{
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status != 200) {
+        return false;
+    }
+
+    Entry entry;
+    entry.status = status;
+    entry.body = body;
+    entry.contentType = reply->rawHeader("Content-Type");
+    applyCacheControl(reply, entry, defaultStaleWhileRevalidate);
+    if (!entry.isValid()) {
+        remove(key);  // no-store：之前缓存的版本也不再保留
+        return false;
+    }
+    return write(key, entry);
+}
+
+ResponseCache::Entry ResponseCache::refresh(const QByteArray& key, QNetworkReply* notModified,
+                                           qint64 defaultStaleWhileRevalidate)
+{
+    Entry entry = lookup(key);
+    if (!entry.isValid()) {
+        return entry;
+    }
+
+    // 304 只携带变化的验证器与缓存指令，缺省的沿用原值
+    const QByteArray etag = notModified->rawHeader("ETag");
+    const QByteArray lastModified = notModified->rawHeader("Last-Modified");
+    Entry updated = entry;
+    applyCacheControl(notModified, updated, defaultStaleWhileRevalidate);
+    if (!updated.isValid()) {
+        remove(key);
+        return entry;  // 本次仍可使用，只是不再缓存
+    }
+    if (etag.isEmpty()) updated.etag = entry.etag;
+    if (lastModified.isEmpty()) updated.lastModified = entry.lastModified;
+    write(key, updated);
+    return updated;
+}
+
+void ResponseCache::remove(const QByteArray& key)
+{
+    QFile::remove(pathFor(key));
+}
+
+void ResponseCache::clear()
+{
+    QDir dir(m_directory);
+    const QStringList files = dir.entryList({QStringLiteral("*") + kSuffix}, QDir::Files);
+    for (const QString& name : files) {
+        dir.remove(name);
+    }
+}
+
+ResponseCache::Headers ResponseCache::conditionalHeaders(const Entry& entry)
+{
+    Headers headers;
+    if (!entry.etag.isEmpty()) {
+        headers.append({QStringLiteral("If-None-Match"), QString::fromLatin1(entry.etag)});
+    }
+    if (!entry.lastModified.isEmpty()) {
+        headers.append({QStringLiteral("If-Modified-Since"), QString::fromLatin1(entry.lastModified)});
+    }
+    return headers;
+}
+
+bool ResponseCache::isNotModified(QNetworkReply* reply)
+{
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304;
+}
+
+QString ResponseCache::pathFor(const QByteArray& key) const
+{
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(key) + kSuffix;
+}
+
+bool ResponseCache::write(const QByteArray& key, const Entry& entry)
+{
+    QSaveFile file(pathFor(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out << kMagic << kVersion;
+    out << entry.status << entry.contentType << entry.etag << entry.lastModified << entry.storedAt
+        << entry.maxAge << entry.staleWhileRevalidate << entry.noCache << entry.body;
+    if (!file.commit()) {
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+void ResponseCache::applyCacheControl(QNetworkReply* reply, Entry& entry, qint64 defaultStaleWhileRevalidate)
+{
+    entry.storedAt = QDateTime::currentDateTimeUtc();
+    entry.etag = reply->rawHeader("ETag");
+    entry.lastModified = reply->rawHeader("Last-Modified");
+    entry.maxAge = 0;
+    entry.staleWhileRevalidate = defaultStaleWhileRevalidate;
+    entry.noCache = false;
+
+    bool hasMaxAge = false;
+    const QList<QByteArray> directives = reply->rawHeader("Cache-Control").split(',');
+    for (const QByteArray& raw : directives) {
+        const QByteArray directive = raw.trimmed().toLower();
+        const qsizetype eq = directive.indexOf('=');
+        const QByteArray name = eq < 0 ? directive : directive.left(eq).trimmed();
+        const QByteArray value = eq < 0 ? QByteArray() : directive.mid(eq + 1).trimmed();
+
+        if (name == "no-store") {
+            entry.status = 0;
+            return;
+        }
+        if (name == "no-cache") {
+            entry.noCache = true;
+        } else if (name == "must-revalidate") {
+            entry.staleWhileRevalidate = 0;
+        } else if (name == "max-age") {
+            entry.maxAge = qMax<qint64>(0, value.toLongLong());
+            hasMaxAge = true;
+        } else if (name == "stale-while-revalidate") {
+            entry.staleWhileRevalidate = qMax<qint64>(0, value.toLongLong());
+        }
+    }
+
+    // 没有 max-age 时退回 Expires（相对服务器的 Date，避免本地时钟偏差）
+    if (!hasMaxAge) {
+        const QDateTime expires = parseHttpDate(reply->rawHeader("Expires"));
+        if (expires.isValid()) {
+            QDateTime date = parseHttpDate(reply->rawHeader("Date"));
+            if (!date.isValid()) {
+                date = entry.storedAt;
+            }
+            entry.maxAge = qMax<qint64>(0, date.secsTo(expires));
+        }
+    }
+}
+
+void ResponseCache::evict()
+{
+    QDir dir(m_directory);
+    // 按修改时间从新到旧
+    const QFileInfoList files = dir.entryInfoList({QStringLiteral("*") + kSuffix}, QDir::Files, QDir::Time);
+    qint64 total = 0;
+    for (const QFileInfo& info : files) {
+        total += info.size();
+        if (total > m_maxBytes) {
+            QFile::remove(info.absoluteFilePath());
+        }
+    }
+}
+
+} // namespace orders
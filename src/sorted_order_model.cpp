@@ -0,0 +1,377 @@
+#include "sorted_order_model.h"
+#include "order_model.h"
+
+#include <algorithm>
+
+namespace orders {
+
+SortedOrderModel::SortedOrderModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+SortedOrderModel::~SortedOrderModel() = default;
+
+int SortedOrderModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) return 0;
+    return static_cast<int>(m_rows.size());
+}
+
+QVariant SortedOrderModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || !m_service || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    const Handle handle = m_rows[static_cast<std::size_t>(index.row())];
+    if (!m_service->store().isAlive(handle)) {
+        return QVariant();
+    }
+    return OrderModel::roleData(m_service->store().at(handle), role);
+}
+
+QHash<int, QByteArray> SortedOrderModel::roleNames() const
+{
+    return OrderModel::orderRoleNames();
+}
+
+void SortedOrderModel::setService(OrdersService* service)
+{
+    if (m_service == service) {
+        return;
+    }
+
+    if (m_service) {
+        disconnect(m_service, nullptr, this, nullptr);
+    }
+
+    m_service = service;
+
+    if (m_service) {
+        connect(m_service, &OrdersService::orderChanges, this, &SortedOrderModel::onOrderChanges);
+    }
+
+    rebuild();
+    emit serviceChanged();
+}
+
+void SortedOrderModel::setSortKeys(const QStringList& keys)
+{
+    if (m_sortKeyNames == keys) {
+        return;
+    }
+
+    m_sortKeyNames = keys;
+    m_sortKeys.clear();
+    for (const QString& name : keys) {
+        const bool descending = name.startsWith(QLatin1Char('-'));
+        const OrderQuery::SortKey field = OrderQuery::sortKeyFromString(descending ? name.mid(1) : name);
+        // "id" is not a column of interned strings or numbers; creation order
+        // is already the final tie-break
+        if (field == OrderQuery::SortKey::None || field == OrderQuery::SortKey::Id) {
+            continue;
+        }
+        if (static_cast<int>(m_sortKeys.size()) == kMaxSortKeys) {
+            break;
+        }
+        m_sortKeys.push_back({field, descending});
+    }
+
+    rebuild();
+    emit sortKeysChanged();
+}
+
+void SortedOrderModel::setFilterStatus(const QString& status)
+{
+    if (m_filterStatus != status) {
+        m_filterStatus = status;
+        rebuild();
+        emit filterStatusChanged();
+    }
+}
+
+void SortedOrderModel::setSearchText(const QString& text)
+{
+    if (m_searchText != text) {
+        m_searchText = text;
+        rebuild();
+        emit searchTextChanged();
+    }
+}
+
+void SortedOrderModel::setResetThreshold(int threshold)
+{
+    if (m_resetThreshold != threshold) {
+        m_resetThreshold = threshold;
+        emit resetThresholdChanged();
+    }
+}
+
+void SortedOrderModel::refresh()
+{
+    rebuild();
+}
+
+QVariantMap SortedOrderModel::get(int index) const
+{
+    if (!m_service || index < 0 || index >= rowCount()) {
+        return {};
+    }
+    return m_service->store().at(m_rows[static_cast<std::size_t>(index)]).toVariantMap();
+}
+
+void SortedOrderModel::onOrderChanges(const OrderChangeSet& changes)
+{
+    if (changes.reset || changes.size() > m_resetThreshold) {
+        rebuild();
+        return;
+    }
+
+    const int oldCount = rowCount();
+    const OrderStore& store = m_service->store();
+
+    // Apply a compaction first (see OrderModel::onOrderChanges): the snapshot
+    // tables move to the new handles, dropped rows are removed. Compaction
+    // keeps creation order, so the tie-break and thus the row order hold.
+    const bool compacted = !changes.remap.isEmpty();
+    if (compacted) {
+        std::vector<Keys> keys(store.slotCount());
+        std::vector<quint8> member(store.slotCount(), 0);
+        for (std::size_t h = 0; h < m_member.size(); ++h) {
+            const Handle to = changes.remap[static_cast<qsizetype>(h)];
+            if (m_member[h] && to != OrderStore::InvalidHandle) {
+                keys[to] = m_keys[h];
+                member[to] = 1;
+            }
+        }
+        m_keys.swap(keys);
+        m_member.swap(member);
+
+        for (Handle& handle : m_rows) {
+            handle = changes.remap[handle];
+        }
+        for (int row = rowCount() - 1; row >= 0; --row) {
+            if (m_rows[static_cast<std::size_t>(row)] == OrderStore::InvalidHandle) {
+                removeRow(row);
+            }
+        }
+    }
+
+    if (m_keys.size() < store.slotCount()) {
+        m_keys.resize(store.slotCount());
+        m_member.resize(store.slotCount(), 0);
+    }
+
+    for (const OrderChange& change : changes.changes) {
+        const Handle handle = compacted ? changes.remap[change.handle] : change.handle;
+        if (handle == OrderStore::InvalidHandle) {
+            continue;  // removed (and compacted away) within this change set
+        }
+
+        const bool inView = m_member[handle];
+        switch (change.kind) {
+        case OrderChange::Kind::Inserted:
+            if (!inView && matchesFilter(handle)) {
+                insertRow(handle);
+            }
+            break;
+        case OrderChange::Kind::Updated: {
+            const bool matches = matchesFilter(handle);
+            if (inView && matches) {
+                repositionRow(rowOf(handle), handle, OrderModel::rolesFor(change.fields));
+            } else if (inView) {
+                removeRow(rowOf(handle));
+            } else if (matches) {
+                insertRow(handle);
+            }
+            break;
+        }
+        case OrderChange::Kind::Removed:
+            if (inView) {
+                removeRow(rowOf(handle));
+            }
+            break;
+        }
+    }
+
+    if (rowCount() != oldCount) {
+        emit countChanged();
+    }
+}
+
+void SortedOrderModel::rebuild()
+{
+    beginResetModel();
+
+    m_rows.clear();
+    m_keys.clear();
+    m_member.clear();
+
+    if (m_service) {
+        const OrderStore& store = m_service->store();
+        m_keys.resize(store.slotCount());
+        m_member.assign(store.slotCount(), 0);
+
+        store.forEach([this](Handle h, const OrderView&) {
+            if (matchesFilter(h)) {
+                m_rows.push_back(h);
+                m_keys[h] = keysOf(h);
+                m_member[h] = 1;
+            }
+        });
+        if (!m_sortKeys.empty()) {
+            std::sort(m_rows.begin(), m_rows.end(),
+                      [this](Handle a, Handle b) { return less(a, b); });
+        }
+    }
+
+    endResetModel();
+    emit countChanged();
+}
+
+bool SortedOrderModel::matchesFilter(Handle handle) const
+{
+    const OrderStore& store = m_service->store();
+    if (!store.isAlive(handle)) {
+        return false;
+    }
+
+    const OrderView order = store.at(handle);
+    if (!m_filterStatus.isEmpty() && order.statusView() != m_filterStatus) {
+        return false;
+    }
+
+    const QString needle = m_searchText.trimmed();
+    return needle.isEmpty()
+        || order.customerNameView().contains(needle, Qt::CaseInsensitive)
+        || order.productNameView().contains(needle, Qt::CaseInsensitive);
+}
+
+SortedOrderModel::Keys SortedOrderModel::keysOf(Handle handle) const
+{
+    const OrderStore& store = m_service->store();
+    Keys keys{};
+    for (std::size_t i = 0; i < m_sortKeys.size(); ++i) {
+        switch (m_sortKeys[i].field) {
+        case OrderQuery::SortKey::CustomerName: keys[i] = store.customerIdAt(handle); break;
+        case OrderQuery::SortKey::ProductName: keys[i] = store.productIdAt(handle); break;
+        case OrderQuery::SortKey::Status: keys[i] = store.statusIdAt(handle); break;
+        case OrderQuery::SortKey::Quantity: keys[i] = store.quantityAt(handle); break;
+        case OrderQuery::SortKey::Price: keys[i] = store.priceMinorAt(handle); break;
+        case OrderQuery::SortKey::Total: keys[i] = store.lineTotalAt(handle); break;
+        case OrderQuery::SortKey::CreatedAt: keys[i] = store.createdAtMs(handle); break;
+        case OrderQuery::SortKey::UpdatedAt: keys[i] = store.updatedAtMs(handle); break;
+        case OrderQuery::SortKey::None:
+        case OrderQuery::SortKey::Id:
+            break;
+        }
+    }
+    return keys;
+}
+
+int SortedOrderModel::compareKey(int i, qint64 a, qint64 b) const
+{
+    switch (m_sortKeys[static_cast<std::size_t>(i)].field) {
+    case OrderQuery::SortKey::CustomerName:
+    case OrderQuery::SortKey::ProductName:
+    case OrderQuery::SortKey::Status: {
+        // Interned string ids: equal ids are equal strings, otherwise compare text
+        if (a == b) {
+            return 0;
+        }
+        const StringPool& strings = m_service->store().strings();
+        return strings.view(static_cast<StringPool::Id>(a))
+            .compare(strings.view(static_cast<StringPool::Id>(b)), Qt::CaseInsensitive);
+    }
+    default:
+        return a < b ? -1 : (b < a ? 1 : 0);
+    }
+}
+
+bool SortedOrderModel::less(Handle a, Handle b) const
+{
+    const Keys& ka = m_keys[a];
+    const Keys& kb = m_keys[b];
+    for (std::size_t i = 0; i < m_sortKeys.size(); ++i) {
+        const int c = compareKey(static_cast<int>(i), ka[i], kb[i]);
+        if (c != 0) {
+            return m_sortKeys[i].descending ? c > 0 : c < 0;
+        }
+    }
+    return a < b;
+}
+
+int SortedOrderModel::rowOf(Handle handle) const
+{
+    // The handle's snapshot is its current position key, so it can be found
+    // by binary search like any other value
+    return insertionRow(handle);
+}
+
+int SortedOrderModel::insertionRow(Handle handle) const
+{
+    auto it = std::lower_bound(m_rows.begin(), m_rows.end(), handle,
+                               [this](Handle a, Handle b) { return less(a, b); });
+    return static_cast<int>(it - m_rows.begin());
+}
+
+void SortedOrderModel::insertRow(Handle handle)
+{
+    m_keys[handle] = keysOf(handle);
+    const int row = insertionRow(handle);
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.insert(m_rows.begin() + row, handle);
+    m_member[handle] = 1;
+    endInsertRows();
+}
+
+void SortedOrderModel::removeRow(int row)
+{
+    const Handle handle = m_rows[static_cast<std::size_t>(row)];
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rows.erase(m_rows.begin() + row);
+    if (handle != OrderStore::InvalidHandle) {
+        m_member[handle] = 0;
+    }
+    endRemoveRows();
+}
+
+void SortedOrderModel::repositionRow(int row, Handle handle, const QList<int>& roles)
+{
+    const Keys keys = keysOf(handle);
+    if (keys != m_keys[handle]) {
+        m_keys[handle] = keys;
+
+        // The rest of the rows are still sorted; the row only needs to move
+        // if its new keys put it before its left or after its right neighbour
+        const auto cmp = [this](Handle a, Handle b) { return less(a, b); };
+        const auto begin = m_rows.begin();
+        int dest = row;   // beginMoveRows destination (index before the move)
+        if (row > 0 && less(handle, m_rows[static_cast<std::size_t>(row - 1)])) {
+            dest = static_cast<int>(std::lower_bound(begin, begin + row, handle, cmp) - begin);
+        } else if (row + 1 < rowCount() && less(m_rows[static_cast<std::size_t>(row + 1)], handle)) {
+            dest = static_cast<int>(std::lower_bound(begin + row + 1, m_rows.end(), handle, cmp) - begin);
+        }
+
+        if (dest != row) {
+            beginMoveRows(QModelIndex(), row, row, QModelIndex(), dest);
+            if (dest < row) {
+                std::rotate(begin + dest, begin + row, begin + row + 1);
+            } else {
+                std::rotate(begin + row, begin + row + 1, begin + dest);
+            }
+            endMoveRows();
+            row = dest < row ? dest : dest - 1;
+        }
+    }
+
+    if (!roles.isEmpty()) {
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx, roles);
+    }
+}
+
+} // namespace orders
@@ -0,0 +1,60 @@
+#include "string_arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace orders {
+
+StringArena::StringArena(qsizetype chunkChars)
+    : m_chunkChars(chunkChars)
+{
+}
+
+QStringView StringArena::store(QStringView str)
+{
+    const qsizetype len = str.size();
+    if (len == 0) {
+        return QStringView(u"");
+    }
+
+    // 当前块放不下时依次尝试后面（reset 后保留下来的）块，都不行再分配新块
+    while (m_current < m_chunks.size() && m_used + len > m_chunks[m_current].capacity) {
+        ++m_current;
+        m_used = 0;
+    }
+    if (m_current == m_chunks.size()) {
+        Chunk chunk;
+        chunk.capacity = std::max(m_chunkChars, len);
+        chunk.data = std::make_unique<char16_t[]>(static_cast<std::size_t>(chunk.capacity));
+        m_chunks.push_back(std::move(chunk));
+        m_used = 0;
+    }
+
+    char16_t* dst = m_chunks[m_current].data.get() + m_used;
+    std::memcpy(dst, str.utf16(), static_cast<std::size_t>(len) * sizeof(char16_t));
+    m_used += len;
+    return QStringView(dst, len);
+}
+
+void StringArena::reset()
+{
+    m_current = 0;
+    m_used = 0;
+}
+
+void StringArena::release()
+{
+    m_chunks.clear();
+    reset();
+}
+
+qsizetype StringArena::bytesReserved() const
+{
+    qsizetype total = 0;
+    for (const Chunk& chunk : m_chunks) {
+        total += chunk.capacity * static_cast<qsizetype>(sizeof(char16_t));
+    }
+    return total;
+}
+
+} // namespace orders
@@ -0,0 +1,26 @@
+#include "string_pool.h"
+
+namespace orders {
+
+StringPool::Id StringPool::intern(QStringView str)
+{
+    auto it = m_ids.constFind(str);
+    if (it != m_ids.constEnd()) {
+        return it.value();
+    }
+
+    const Id id = static_cast<Id>(m_strings.size());
+    const QStringView stored = m_arena.store(str);
+    m_strings.push_back(stored);
+    m_ids.insert(stored, id);
+    return id;
+}
+
+void StringPool::clear()
+{
+    m_strings.clear();
+    m_ids.clear();
+    m_arena.reset();
+}
+
+} // namespace orders
@@ -0,0 +1,127 @@
+#include "time_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace orders {
+
+void TimeIndex::insert(qint64 timeMs, Handle handle)
+{
+    const Entry entry{timeMs, handle, 0};
+    if (m_run.empty() || m_run.back() < entry) {
+        m_run.push_back(entry);  // 快速路径：按时间顺序到达
+        return;
+    }
+
+    m_buffer.push_back(entry);
+    if (m_buffer.size() > bufferLimit()) {
+        merge();
+    }
+}
+
+void TimeIndex::remove(qint64 timeMs, Handle handle)
+{
+    const Entry key{timeMs, handle, 0};
+    auto it = std::lower_bound(m_run.begin(), m_run.end(), key);
+    if (it != m_run.end() && it->timeMs == timeMs && it->handle == handle && !it->removed) {
+        it->removed = 1;
+        ++m_removed;
+        if (static_cast<std::size_t>(m_removed) > m_run.size() / 2 && m_removed > static_cast<int>(kMinBufferLimit)) {
+            merge();
+        }
+        return;
+    }
+
+    for (auto bit = m_buffer.begin(); bit != m_buffer.end(); ++bit) {
+        if (bit->timeMs == timeMs && bit->handle == handle) {
+            *bit = m_buffer.back();
+            m_buffer.pop_back();
+            return;
+        }
+    }
+}
+
+void TimeIndex::clear()
+{
+    m_run.clear();
+    m_buffer.clear();
+    m_removed = 0;
+}
+
+void TimeIndex::remap(const QVector<Handle>& remap)
+{
+    merge();  // 顺带清理删除标记，剩下的条目都对应存活订单
+    for (Entry& entry : m_run) {
+        entry.handle = remap[static_cast<qsizetype>(entry.handle)];
+    }
+}
+
+std::vector<TimeIndex::Handle> TimeIndex::range(qint64 fromMs, qint64 toMs) const
+{
+    std::vector<Handle> result;
+    if (fromMs >= toMs) {
+        return result;
+    }
+
+    auto lo = std::lower_bound(m_run.begin(), m_run.end(), fromMs,
+        [](const Entry& e, qint64 t) { return e.timeMs < t; });
+    auto hi = std::lower_bound(lo, m_run.end(), toMs,
+        [](const Entry& e, qint64 t) { return e.timeMs < t; });
+
+    std::vector<Entry> extra;
+    for (const Entry& e : m_buffer) {
+        if (e.timeMs >= fromMs && e.timeMs < toMs) {
+            extra.push_back(e);
+        }
+    }
+    std::sort(extra.begin(), extra.end());
+
+    // 主段区间与缓冲命中项做一次有序归并
+    result.reserve(static_cast<std::size_t>(hi - lo) + extra.size());
+    auto x = extra.begin();
+    for (auto it = lo; it != hi; ++it) {
+        if (it->removed) {
+            continue;
+        }
+        while (x != extra.end() && *x < *it) {
+            result.push_back((x++)->handle);
+        }
+        result.push_back(it->handle);
+    }
+    for (; x != extra.end(); ++x) {
+        result.push_back(x->handle);
+    }
+    return result;
+}
+
+void TimeIndex::merge()
+{
+    std::sort(m_buffer.begin(), m_buffer.end());
+
+    std::vector<Entry> merged;
+    merged.reserve(m_run.size() - static_cast<std::size_t>(m_removed) + m_buffer.size());
+    auto b = m_buffer.begin();
+    for (const Entry& e : m_run) {
+        if (e.removed) {
+            continue;
+        }
+        while (b != m_buffer.end() && *b < e) {
+            merged.push_back(*b++);
+        }
+        merged.push_back(e);
+    }
+    merged.insert(merged.end(), b, m_buffer.end());
+
+    m_run.swap(merged);
+    m_buffer.clear();
+    m_removed = 0;
+}
+
+std::size_t TimeIndex::bufferLimit() const
+{
+    // 缓冲上限取 √n：合并的均摊代价与查询时扫描缓冲的代价相当
+    const auto sqrtN = static_cast<std::size_t>(std::sqrt(static_cast<double>(m_run.size())));
+    return std::max(kMinBufferLimit, sqrtN);
+}
+
+} // namespace orders
@@ -0,0 +1,81 @@
+#include "trigram_index.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace orders {
+
+quint64 TrigramIndex::gramKey(const QChar* s)
+{
+    return (quint64(s[0].unicode()) << 32) | (quint64(s[1].unicode()) << 16) | quint64(s[2].unicode());
+}
+
+void TrigramIndex::add(Id id, QStringView text)
+{
+    if (contains(id)) {
+        return;
+    }
+    if (id >= m_indexed.size()) {
+        m_indexed.resize(static_cast<std::size_t>(id) + 1, 0);
+    }
+    m_indexed[id] = 1;
+
+    const QString folded = text.toString().toCaseFolded();
+    for (qsizetype i = 0; i + kGramSize <= folded.size(); ++i) {
+        std::vector<Id>& list = m_postings[gramKey(folded.constData() + i)];
+        if (list.empty() || list.back() < id) {
+            list.push_back(id);
+            continue;
+        }
+        // 同一字符串内重复的 trigram，或 ID 乱序到达（该字符串先以状态身份被驻留）
+        auto pos = std::lower_bound(list.begin(), list.end(), id);
+        if (pos == list.end() || *pos != id) {
+            list.insert(pos, id);
+        }
+    }
+}
+
+std::vector<TrigramIndex::Id> TrigramIndex::candidates(QStringView query) const
+{
+    const QString folded = query.toString().toCaseFolded();
+    if (folded.size() < kGramSize) {
+        return {};
+    }
+
+    // 收集各 trigram 的列表，任何一个不存在即无结果
+    std::vector<const std::vector<Id>*> lists;
+    for (qsizetype i = 0; i + kGramSize <= folded.size(); ++i) {
+        auto it = m_postings.constFind(gramKey(folded.constData() + i));
+        if (it == m_postings.constEnd()) {
+            return {};
+        }
+        lists.push_back(&it.value());
+    }
+
+    // 从最短的列表开始求交集，中间结果只会越来越小
+    std::sort(lists.begin(), lists.end(),
+        [](const std::vector<Id>* a, const std::vector<Id>* b) {
+            return a->size() != b->size() ? a->size() < b->size() : std::less<>()(a, b);
+        });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    std::vector<Id> result = *lists.front();
+    std::vector<Id> scratch;
+    for (std::size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        scratch.clear();
+        std::set_intersection(result.begin(), result.end(),
+                              lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(scratch));
+        result.swap(scratch);
+    }
+    return result;
+}
+
+void TrigramIndex::clear()
+{
+    m_postings.clear();
+    m_indexed.clear();
+}
+
+} // namespace orders
@@ -0,0 +1,144 @@
+/**
+ * =============================================================================
+ * StubHttpServer - 测试用的本地 HTTP 桩服务器
+ * =============================================================================
+ *
+ * 基于 QTcpServer，只监听 127.0.0.1 的随机端口：
+ * - enqueue() 按顺序排入预设的响应，每收到一个请求取出一个
+ * - requests() 记录收到的请求（请求行与请求头），用于检查游标、验证器等
+ * - 每个响应都带 Connection: close，一个连接只处理一个请求
+ *
+ * 只解析请求头，不读取请求体（被测的同步请求都是 GET）。
+ * =============================================================================
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrl>
+#include <QUrlQuery>
+
+#include <memory>
+
+namespace orders::test {
+
+class StubHttpServer
+{
+public:
+    struct Response {
+        int status = 200;
+        QList<QPair<QByteArray, QByteArray>> headers;
+        QByteArray body;
+        bool hold = false;  // 不回复，连接保持打开（模拟进行中的慢请求）
+    };
+
+    struct Request {
+        QByteArray method;
+        QByteArray target;                     // 路径与查询串
+        QMap<QByteArray, QByteArray> headers;  // 名称为小写
+
+        QUrlQuery query() const
+        {
+            return QUrlQuery(QUrl::fromEncoded(target).query());
+        }
+    };
+
+    StubHttpServer()
+    {
+        m_server.listen(QHostAddress::LocalHost);
+        QObject::connect(&m_server, &QTcpServer::newConnection, &m_server, [this]() {
+            while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+                accept(socket);
+            }
+        });
+    }
+
+    bool isListening() const { return m_server.isListening(); }
+
+    QString url(const QString& path) const
+    {
+        return QStringLiteral("http://127.0.0.1:%1%2").arg(m_server.serverPort()).arg(path);
+    }
+
+    void enqueue(Response response) { m_responses.append(std::move(response)); }
+
+    QList<Request> requests() const { return m_requests; }
+
+private:
+    void accept(QTcpSocket* socket)
+    {
+        auto buffer = std::make_shared<QByteArray>();
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() {
+            buffer->append(socket->readAll());
+            const qsizetype end = buffer->indexOf("\r\n\r\n");
+            if (end < 0) {
+                return;  // 请求头还不完整
+            }
+            handle(socket, buffer->left(end));
+            buffer->clear();
+        });
+    }
+
+    void handle(QTcpSocket* socket, const QByteArray& head)
+    {
+        const QList<QByteArray> lines = head.split('\n');
+        const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+
+        Request request;
+        request.method = requestLine.value(0);
+        request.target = requestLine.value(1);
+        for (qsizetype i = 1; i < lines.size(); ++i) {
+            const qsizetype colon = lines[i].indexOf(':');
+            if (colon > 0) {
+                request.headers.insert(lines[i].left(colon).trimmed().toLower(), lines[i].mid(colon + 1).trimmed());
+            }
+        }
+        m_requests.append(request);
+
+        Response response;
+        if (m_responses.isEmpty()) {
+            response.status = 500;
+            response.body = "no response queued";
+        } else {
+            response = m_responses.takeFirst();
+        }
+        if (response.hold) {
+            return;
+        }
+
+        QByteArray out = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reason(response.status) + "\r\n";
+        out += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+        out += "Connection: close\r\n";
+        for (const auto& header : std::as_const(response.headers)) {
+            out += header.first + ": " + header.second + "\r\n";
+        }
+        out += "\r\n";
+        out += response.body;
+
+        socket->write(out);
+        socket->disconnectFromHost();  // 待发送的数据写完后再关闭
+    }
+
+    static QByteArray reason(int status)
+    {
+        switch (status) {
+        case 200: return "OK";
+        case 304: return "Not Modified";
+        case 404: return "Not Found";
+        default: return "Internal Server Error";
+        }
+    }
+
+    QTcpServer m_server;
+    QList<Response> m_responses;
+    QList<Request> m_requests;
+};
+
+} // namespace orders::test
@@ -0,0 +1,91 @@
+/**
+ * =============================================================================
+ * SnowflakeIdGenerator 的编码测试
+ * =============================================================================
+ *
+ * - encode()/decode() 往返，覆盖时间戳高位（首字符承载第 60~63 位）
+ * - 首字符超出 0~7（第 63 位置位）或长度不符时解码失败
+ * =============================================================================
+ */
+
+#include "order_id_generator.h"
+
+#include <QTest>
+
+using namespace orders;
+
+namespace {
+
+constexpr int kTimestampShift = SnowflakeIdGenerator::kNodeBits + SnowflakeIdGenerator::kSequenceBits;
+
+quint64 makeId(quint64 timestamp, quint64 node, quint64 sequence)
+{
+    return (timestamp << kTimestampShift) | (node << SnowflakeIdGenerator::kSequenceBits) | sequence;
+}
+
+} // namespace
+
+class TestOrderIdGenerator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip_data();
+    void roundTrip();
+    void rejectsInvalidText();
+    void generatedIdsIncrease();
+};
+
+void TestOrderIdGenerator::roundTrip_data()
+{
+    constexpr quint64 maxTimestamp = (quint64(1) << SnowflakeIdGenerator::kTimestampBits) - 1;
+
+    QTest::addColumn<quint64>("id");
+    QTest::newRow("zero") << quint64(0);
+    QTest::newRow("small") << makeId(1, 1, 1);
+    // 2^38 ms 之后（约 2033 年）时间戳进入首字符
+    QTest::newRow("timestamp bit 38") << makeId(quint64(1) << 38, 3, 7);
+    QTest::newRow("max timestamp") << makeId(maxTimestamp, SnowflakeIdGenerator::kMaxNodeId, 4095);
+}
+
+void TestOrderIdGenerator::roundTrip()
+{
+    QFETCH(quint64, id);
+
+    const QString text = SnowflakeIdGenerator::encode(id);
+    QCOMPARE(text.size(), SnowflakeIdGenerator::kEncodedLength);
+
+    bool ok = false;
+    QCOMPARE(SnowflakeIdGenerator::decode(text, &ok), id);
+    QVERIFY(ok);
+    QCOMPARE(SnowflakeIdGenerator::decode(text.toLower(), &ok), id);
+    QVERIFY(ok);
+}
+
+void TestOrderIdGenerator::rejectsInvalidText()
+{
+    bool ok = true;
+    SnowflakeIdGenerator::decode(u"8000000000000", &ok);  // 第 63 位保留
+    QVERIFY(!ok);
+    SnowflakeIdGenerator::decode(u"000000000000", &ok);   // 长度不符
+    QVERIFY(!ok);
+    SnowflakeIdGenerator::decode(u"00000000000U0", &ok);  // 不在字母表中
+    QVERIFY(!ok);
+
+    SnowflakeIdGenerator::decode(u"7ZZZZZZZZZZZZ", &ok);
+    QVERIFY(ok);
+}
+
+void TestOrderIdGenerator::generatedIdsIncrease()
+{
+    SnowflakeIdGenerator generator(5);
+    QString previous = generator.next();
+    for (int i = 0; i < 10000; ++i) {
+        const QString id = generator.next();
+        QVERIFY(id > previous);
+        previous = id;
+    }
+}
+
+QTEST_GUILESS_MAIN(TestOrderIdGenerator)
+#include "tst_order_id_generator.moc"
@@ -0,0 +1,236 @@
+/**
+ * =============================================================================
+ * OrdersService::syncOrders 的增量同步协议测试
+ * =============================================================================
+ *
+ * 对着本地桩服务器（StubHttpServer）验证：
+ * - 游标：首次同步不带 since，之后带上次响应的 cursor
+ * - 验证器：带上次的 ETag 作为 If-None-Match，304 时数据与游标都不变
+ * - deleted：响应中列出的订单被删除，orders 中的订单被新增或覆盖
+ * - 无法解析的响应：报告失败，不记住其 ETag，下次同步重新请求
+ * - 切换地址：被取代的同步不会报告失败
+ * =============================================================================
+ */
+
+#include "orders_service.h"
+#include "stub_http_server.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace orders;
+using orders::test::StubHttpServer;
+
+namespace {
+
+QJsonObject orderJson(const QString& id, const QString& status, const QString& updatedAt)
+{
+    return {
+        {"id", id},
+        {"customerName", "Customer " + id},
+        {"productName", "Product"},
+        {"quantity", 1},
+        {"price", 9.99},
+        {"status", status},
+        {"createdAt", "2024-01-01T00:00:00.000Z"},
+        {"updatedAt", updatedAt}
+    };
+}
+
+StubHttpServer::Response syncResponse(const QByteArray& etag, const QJsonArray& orders,
+                                      const QJsonArray& deleted, const QString& cursor)
+{
+    StubHttpServer::Response response;
+    response.headers = {{"Content-Type", "application/json"}, {"ETag", etag}};
+    response.body = QJsonDocument(QJsonObject{
+        {"orders", orders},
+        {"deleted", deleted},
+        {"cursor", cursor}
+    }).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+StubHttpServer::Response notModified()
+{
+    StubHttpServer::Response response;
+    response.status = 304;
+    return response;
+}
+
+} // namespace
+
+class TestSyncOrders : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cursorEtagAndDeletes();
+    void notModifiedKeepsData();
+    void invalidBodyDoesNotStoreEtag();
+    void urlSwitchDoesNotReportSupersededSync();
+};
+
+void TestSyncOrders::cursorEtagAndDeletes()
+{
+    StubHttpServer server;
+    QVERIFY(server.isListening());
+    server.enqueue(syncResponse("\"v1\"",
+                                {orderJson("A", "pending", "2024-01-01T10:00:00.000Z"),
+                                 orderJson("B", "pending", "2024-01-01T11:00:00.000Z")},
+                                {}, "c1"));
+    server.enqueue(syncResponse("\"v2\"",
+                                {orderJson("B", "shipped", "2024-01-02T09:00:00.000Z")},
+                                {"A"}, "c2"));
+    server.enqueue(syncResponse("\"v3\"", {}, {}, "c3"));
+
+    OrdersService service;
+    QSignalSpy spy(&service, &OrdersService::syncCompleted);
+    const QString url = server.url("/orders");
+
+    // 首次同步：不带游标与验证器，拿到全部订单
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    QList<QVariant> result = spy.takeFirst();
+    QCOMPARE(result.at(0).toBool(), true);
+    QCOMPARE(result.at(1).toInt(), 2);
+    QCOMPARE(result.at(2).toInt(), 0);
+    QCOMPARE(service.getOrderCount(), 2);
+
+    QCOMPARE(server.requests().size(), 1);
+    StubHttpServer::Request request = server.requests().at(0);
+    QVERIFY(!request.query().hasQueryItem("since"));
+    QVERIFY(!request.headers.contains("if-none-match"));
+
+    // 第二次：带 since=c1 与 If-None-Match，按 ID 覆盖 B、删除 A
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    result = spy.takeFirst();
+    QCOMPARE(result.at(0).toBool(), true);
+    QCOMPARE(result.at(1).toInt(), 1);
+    QCOMPARE(result.at(2).toInt(), 1);
+    QCOMPARE(service.getOrderCount(), 1);
+    QVERIFY(service.getOrder("A").isEmpty());
+    QCOMPARE(service.getOrder("B").value("status").toString(), QStringLiteral("shipped"));
+
+    request = server.requests().at(1);
+    QCOMPARE(request.query().queryItemValue("since"), QStringLiteral("c1"));
+    QCOMPARE(request.headers.value("if-none-match"), QByteArray("\"v1\""));
+
+    // 第三次：游标与验证器前进到第二次响应的值
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.takeFirst().at(0).toBool(), true);
+
+    request = server.requests().at(2);
+    QCOMPARE(request.query().queryItemValue("since"), QStringLiteral("c2"));
+    QCOMPARE(request.headers.value("if-none-match"), QByteArray("\"v2\""));
+}
+
+void TestSyncOrders::notModifiedKeepsData()
+{
+    StubHttpServer server;
+    QVERIFY(server.isListening());
+    server.enqueue(syncResponse("\"v1\"", {orderJson("A", "pending", "2024-01-01T10:00:00.000Z")}, {}, "c1"));
+    server.enqueue(notModified());
+    server.enqueue(syncResponse("\"v2\"", {}, {}, "c2"));
+
+    OrdersService service;
+    QSignalSpy spy(&service, &OrdersService::syncCompleted);
+    const QString url = server.url("/orders");
+
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    spy.clear();
+
+    // 304：没有变化，数据保持不变
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    const QList<QVariant> result = spy.takeFirst();
+    QCOMPARE(result.at(0).toBool(), true);
+    QCOMPARE(result.at(1).toInt(), 0);
+    QCOMPARE(result.at(2).toInt(), 0);
+    QCOMPARE(service.getOrderCount(), 1);
+
+    // 304 之后仍使用原来的游标与验证器
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    const StubHttpServer::Request request = server.requests().at(2);
+    QCOMPARE(request.query().queryItemValue("since"), QStringLiteral("c1"));
+    QCOMPARE(request.headers.value("if-none-match"), QByteArray("\"v1\""));
+}
+
+void TestSyncOrders::invalidBodyDoesNotStoreEtag()
+{
+    StubHttpServer server;
+    QVERIFY(server.isListening());
+    StubHttpServer::Response invalid;
+    invalid.headers = {{"Content-Type", "application/json"}, {"ETag", "\"bad\""}};
+    invalid.body = "{\"orders\": [";
+    server.enqueue(invalid);
+    server.enqueue(syncResponse("\"v1\"", {orderJson("A", "pending", "2024-01-01T10:00:00.000Z")}, {}, "c1"));
+    server.enqueue(syncResponse("\"v2\"", {}, {}, "c2"));
+    server.enqueue(notModified());
+
+    OrdersService service;
+    QSignalSpy spy(&service, &OrdersService::syncCompleted);
+    const QString url = server.url("/orders");
+
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.takeFirst().at(0).toBool(), false);
+    QCOMPARE(service.getOrderCount(), 0);
+
+    // 失败的响应既不推进游标，也不留下 ETag：重试拿到完整的变化而不是 304
+    service.syncOrders(url);
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.takeFirst().at(0).toBool(), true);
+    QCOMPARE(service.getOrderCount(), 1);
+
+    StubHttpServer::Request request = server.requests().at(1);
+    QVERIFY(!request.query().hasQueryItem("since"));
+    QVERIFY(!request.headers.contains("if-none-match"));
+
+    // syncCompleted 发出时新的 ETag 已经生效：在槽函数中立即再次同步会带上它
+    QSignalSpy resynced(&service, &OrdersService::syncCompleted);
+    QMetaObject::Connection connection = connect(&service, &OrdersService::syncCompleted, &service,
+        [&service, &connection, url]() {
+            QObject::disconnect(connection);
+            service.syncOrders(url);
+        });
+    service.syncOrders(url);
+    QTRY_COMPARE(resynced.size(), 2);
+
+    request = server.requests().at(2);
+    QCOMPARE(request.headers.value("if-none-match"), QByteArray("\"v1\""));
+    request = server.requests().at(3);
+    QCOMPARE(request.headers.value("if-none-match"), QByteArray("\"v2\""));
+}
+
+void TestSyncOrders::urlSwitchDoesNotReportSupersededSync()
+{
+    StubHttpServer server;
+    QVERIFY(server.isListening());
+    StubHttpServer::Response slow;
+    slow.hold = true;
+    server.enqueue(slow);
+    server.enqueue(syncResponse("\"v1\"", {orderJson("A", "pending", "2024-01-01T10:00:00.000Z")}, {}, "c1"));
+
+    OrdersService service;
+    QSignalSpy spy(&service, &OrdersService::syncCompleted);
+
+    service.syncOrders(server.url("/slow"));
+    QTRY_COMPARE(server.requests().size(), 1);
+
+    // 切换地址会中止进行中的同步；只报告新地址的结果
+    service.syncOrders(server.url("/orders"));
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.size(), 1);
+    QCOMPARE(spy.at(0).at(0).toBool(), true);
+    QCOMPARE(service.getOrderCount(), 1);
+}
+
+QTEST_GUILESS_MAIN(TestSyncOrders)
+#include "tst_sync_orders.moc"